@@ -0,0 +1,182 @@
+#include "input_file_loader.h"
+#include "instrumentation.h"
+#include "result_cache.h"
+#include "days.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Job
+{
+  int day;
+  std::filesystem::path input;
+};
+
+struct Outcome
+{
+  Answers answers;
+  std::string error;
+  clock_type::duration wall_time{};
+  std::string timing;
+  bool cached{ false };
+};
+
+std::optional<int> to_int(std::string_view str)
+{
+  int result;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+  if (ec == std::errc{} && ptr == str.data() + str.size()) {
+    return result;
+  } else {
+    return std::nullopt;
+  }
+}
+
+// Days are given as "N" to use the default input or "N=path" to override it.
+std::optional<Job> parse_job(std::string_view arg)
+{
+  const auto separator = arg.find('=');
+  const auto day = to_int(arg.substr(0, separator));
+  if (!day || *day < 1 || *day > static_cast<int>(solvers.size())) {
+    return std::nullopt;
+  } else if (separator == std::string_view::npos) {
+    return Job{ *day, default_input_path(*day) };
+  } else {
+    return Job{ *day, std::filesystem::path{ arg.substr(separator + 1) } };
+  }
+}
+
+Outcome run(const Job &job, const InstrumentationOptions &options, const std::optional<ResultCache> &cache)
+{
+  Outcome outcome;
+  const auto start = clock_type::now();
+  try {
+    const auto key = cache ? cache->key(job.day, job.input) : std::nullopt;
+    // Entries from untimed runs cannot answer a timed one.
+    if (auto hit = key ? cache->find(*key) : std::nullopt; hit && (!options.enabled || !hit->timing.empty())) {
+      outcome.answers = std::move(hit->answers);
+      outcome.timing = std::move(hit->timing);
+      outcome.cached = true;
+    } else {
+      Instrumentation instrumentation;
+      {
+        std::optional<InstrumentationScope> scope;
+        if (options.enabled) scope.emplace(instrumentation);
+        for (std::size_t i = 0; i < options.repetitions; ++i) {
+          outcome.answers = solvers[job.day - 1](job.input);
+        }
+      }
+      if (options.enabled) {
+        outcome.timing = instrumentation.to_json(fmt::format("day{}", job.day), job.input.string(), options.repetitions);
+      }
+      if (key) cache->store(*key, CachedResult{ outcome.answers, outcome.timing });
+    }
+  } catch (const std::exception &e) {
+    outcome.error = e.what();
+  }
+  outcome.wall_time = clock_type::now() - start;
+  return outcome;
+}
+
+std::vector<Outcome> run_all(const std::vector<Job> &jobs, const InstrumentationOptions &options, const std::optional<ResultCache> &cache, unsigned n_threads)
+{
+  std::vector<Outcome> outcomes(jobs.size());
+  std::atomic<std::size_t> next{ 0 };
+  const auto worker = [&] {
+    for (auto i = next++; i < jobs.size(); i = next++) {
+      outcomes[i] = run(jobs[i], options, cache);
+    }
+  };
+
+  std::vector<std::jthread> pool;
+  for (unsigned i = 1; i < n_threads; ++i) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  return outcomes;
+}
+
+double milliseconds(clock_type::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void print_usage(const char *program)
+{
+  fmt::print(stderr, "Usage: {} [--timing] [--repeat n] [--cache directory] [-j threads] [day | day=input]...\n", program);
+}
+
+}// namespace
+
+int main(int argc, char **argv)
+{
+  InstrumentationOptions options;
+  std::optional<ResultCache> cache;
+  try {
+    options = parse_instrumentation_options(argc, argv);
+    cache = parse_cache_options(argc, argv);
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "Error: {}\n", e.what());
+    return 1;
+  }
+  unsigned n_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<Job> jobs;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{ argv[i] };
+    if (arg == "-j" && i + 1 < argc) {
+      const auto value = to_int(argv[++i]);
+      if (!value || *value < 1) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      n_threads = static_cast<unsigned>(*value);
+    } else if (const auto job = parse_job(arg); job) {
+      jobs.push_back(*job);
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (jobs.empty()) {
+    for (int day = 1; day <= static_cast<int>(solvers.size()); ++day) {
+      jobs.push_back(Job{ day, default_input_path(day) });
+    }
+  }
+  n_threads = std::min(n_threads, static_cast<unsigned>(jobs.size()));
+
+  const auto start = clock_type::now();
+  const auto outcomes = run_all(jobs, options, cache, n_threads);
+  const auto total = clock_type::now() - start;
+
+  int failures = 0;
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    const auto &outcome = outcomes[i];
+    fmt::print("Day {} ({:.3f} ms{})\n", jobs[i].day, milliseconds(outcome.wall_time), outcome.cached ? ", cached" : "");
+    if (!outcome.error.empty()) {
+      fmt::print("  Error: {}\n", outcome.error);
+      ++failures;
+      continue;
+    }
+    fmt::print("  Part 1: {}\n", outcome.answers.part1);
+    if (!outcome.answers.part2.empty()) {
+      fmt::print("  Part 2: {}\n", outcome.answers.part2);
+    }
+    if (!outcome.timing.empty()) {
+      fmt::print(stderr, "{}\n", outcome.timing);
+    }
+  }
+  fmt::print("Total: {:.3f} ms for {} days on {} threads\n", milliseconds(total), jobs.size(), n_threads);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include "input_generators.h"
+#include "days.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct BenchOptions
+{
+  std::size_t iterations{ 10 };
+  double scale{ 1.0 };
+  std::uint64_t seed{ 2020 };
+  std::vector<int> days;
+};
+
+template<typename T>
+std::optional<T> to_number(std::string_view str)
+{
+  T result;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+  if (ec == std::errc{} && ptr == str.data() + str.size()) {
+    return result;
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::optional<BenchOptions> parse_options(int argc, char **argv)
+{
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{ argv[i] };
+    const bool has_value = i + 1 < argc;
+    if (arg == "--iterations" && has_value) {
+      const auto value = to_number<std::size_t>(argv[++i]);
+      if (!value || *value == 0) return std::nullopt;
+      options.iterations = *value;
+    } else if (arg == "--scale" && has_value) {
+      const auto value = to_number<double>(argv[++i]);
+      if (!value || !(*value > 0)) return std::nullopt;
+      options.scale = *value;
+    } else if (arg == "--seed" && has_value) {
+      const auto value = to_number<std::uint64_t>(argv[++i]);
+      if (!value) return std::nullopt;
+      options.seed = *value;
+    } else if (const auto day = to_number<int>(arg); day && *day >= 1 && *day <= static_cast<int>(solvers.size())) {
+      options.days.push_back(*day);
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (options.days.empty()) {
+    for (int day = 1; day <= static_cast<int>(solvers.size()); ++day) {
+      options.days.push_back(day);
+    }
+  }
+  return options;
+}
+
+void set_option(const std::string &name, const std::string &value)
+{
+  const auto variable = "AOC_" + name;
+#ifdef _WIN32
+  _putenv_s(variable.c_str(), value.c_str());
+#else
+  setenv(variable.c_str(), value.c_str(), 1);
+#endif
+}
+
+void clear_option(const std::string &name)
+{
+  const auto variable = "AOC_" + name;
+#ifdef _WIN32
+  _putenv_s(variable.c_str(), "");
+#else
+  unsetenv(variable.c_str());
+#endif
+}
+
+std::optional<std::string> get_option(const std::string &name)
+{
+  const auto *value = std::getenv(("AOC_" + name).c_str());
+  return value ? std::optional<std::string>{ value } : std::nullopt;
+}
+
+// Exports the options of a generated input for as long as the guard lives,
+// then restores the values they had before.
+class OptionsGuard
+{
+public:
+  explicit OptionsGuard(const GeneratedInput &input)
+  {
+    for (const auto &[name, value] : input.options) {
+      m_previous.emplace_back(name, get_option(name));
+      set_option(name, value);
+    }
+  }
+
+  ~OptionsGuard()
+  {
+    for (auto it = m_previous.rbegin(); it != m_previous.rend(); ++it) {
+      if (it->second) {
+        set_option(it->first, *it->second);
+      } else {
+        clear_option(it->first);
+      }
+    }
+  }
+
+  OptionsGuard(const OptionsGuard &) = delete;
+  OptionsGuard &operator=(const OptionsGuard &) = delete;
+
+private:
+  std::vector<std::pair<std::string, std::optional<std::string>>> m_previous;
+};
+
+struct BenchResult
+{
+  Answers answers;
+  std::vector<clock_type::duration> samples;
+};
+
+BenchResult bench(solver_t solver, const std::filesystem::path &input, std::size_t iterations)
+{
+  BenchResult result;
+  result.answers = solver(input);
+  result.samples.reserve(iterations);
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const auto start = clock_type::now();
+    solver(input);
+    result.samples.push_back(clock_type::now() - start);
+  }
+  std::sort(result.samples.begin(), result.samples.end());
+  return result;
+}
+
+// Nearest-rank percentile of sorted samples.
+clock_type::duration percentile(const std::vector<clock_type::duration> &sorted, double p)
+{
+  const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+double milliseconds(clock_type::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void print_usage(const char *program)
+{
+  fmt::print(stderr, "Usage: {} [--iterations n] [--scale factor] [--seed n] [day]...\n", program);
+}
+
+}// namespace
+
+int main(int argc, char **argv)
+{
+  const auto options = parse_options(argc, argv);
+  if (!options) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  const auto directory = std::filesystem::temp_directory_path();
+  fmt::print("Scale {}, {} iterations, seed {}\n", options->scale, options->iterations, options->seed);
+  fmt::print("{:>5} {:>10} {:>12} {:>12} {:>12}\n", "day", "input KiB", "median ms", "p99 ms", "MB/s");
+
+  int failures = 0;
+  for (const auto day : options->days) {
+    try {
+      const auto generated = generate_input(day, options->scale, options->seed + static_cast<std::uint64_t>(day));
+      const auto path = directory / fmt::format("aoc-bench-day{}.txt", day);
+      std::ofstream{ path, std::ios::binary } << generated.text;
+
+      const OptionsGuard guard{ generated };
+      const auto result = bench(solvers[day - 1], path, options->iterations);
+      std::filesystem::remove(path);
+
+      const auto median = percentile(result.samples, 50);
+      const auto p99 = percentile(result.samples, 99);
+      const auto megabytes = static_cast<double>(generated.text.size()) / 1e6;
+      fmt::print("{:>5} {:>10.1f} {:>12.3f} {:>12.3f} {:>12.2f}\n",
+        day,
+        static_cast<double>(generated.text.size()) / 1024.0,
+        milliseconds(median),
+        milliseconds(p99),
+        megabytes / std::chrono::duration<double>(median).count());
+      fmt::print(stderr, "day{}: {} / {}\n", day, result.answers.part1, result.answers.part2);
+    } catch (const std::exception &e) {
+      fmt::print("{:>5} Error: {}\n", day, e.what());
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#include "chunked_parse.h"
+#include "options.h"
+
+#include <algorithm>
+
+std::vector<std::string_view> split_chunks(std::string_view text, std::size_t n_chunks, std::string_view delimiter)
+{
+  std::vector<std::string_view> chunks;
+  const auto target = text.size() / std::max<std::size_t>(1, n_chunks) + 1;
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    auto end = text.size();
+    if (begin + target < text.size()) {
+      const auto found = text.find(delimiter, begin + target);
+      if (found != std::string_view::npos) end = found + delimiter.size();
+    }
+    chunks.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+std::size_t parse_chunk_count(std::size_t size)
+{
+  constexpr std::size_t min_chunk_size = 1 << 20;
+  const auto threads = option("PARSE_THREADS", std::max(1u, std::thread::hardware_concurrency()));
+  return std::clamp<std::size_t>(size / min_chunk_size, 1, std::max(1u, threads));
+}
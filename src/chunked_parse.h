@@ -0,0 +1,68 @@
+#ifndef AOC2020_CHUNKED_PARSE_
+#define AOC2020_CHUNKED_PARSE_
+
+#include <exception>
+#include <iterator>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Splits text into at most n_chunks pieces of similar size. Every cut is
+// placed right after a delimiter, so no record is split between chunks.
+std::vector<std::string_view> split_chunks(std::string_view text, std::size_t n_chunks, std::string_view delimiter = "\n");
+
+// Number of chunks worth parsing text of the given size in parallel: one per
+// thread (AOC_PARSE_THREADS, by default the hardware concurrency) but none
+// smaller than a megabyte, so puzzle-sized inputs stay on the calling thread.
+std::size_t parse_chunk_count(std::size_t size);
+
+// Parses the records of text chunk by chunk on worker threads.
+// parse_chunk(std::string_view) returns a vector of records for one chunk;
+// the vectors are concatenated in input order. Other containers with size(),
+// reserve() and append(container&&) are joined through append.
+template<typename F>
+auto parse_chunked(std::string_view text, F &&parse_chunk, std::string_view delimiter = "\n")
+{
+  using result_t = std::invoke_result_t<F &, std::string_view>;
+  const auto chunks = split_chunks(text, parse_chunk_count(text.size()), delimiter);
+  if (chunks.size() <= 1) {
+    return parse_chunk(chunks.empty() ? text : chunks.front());
+  }
+
+  std::vector<result_t> partial(chunks.size());
+  std::vector<std::exception_ptr> errors(chunks.size());
+  const auto run = [&](std::size_t i) {
+    try {
+      partial[i] = parse_chunk(chunks[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> workers;
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+      workers.emplace_back(run, i);
+    }
+    run(0);
+  }
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+
+  std::size_t total = 0;
+  for (const auto &p : partial) total += p.size();
+  auto result = std::move(partial.front());
+  result.reserve(total);
+  for (auto it = partial.begin() + 1; it != partial.end(); ++it) {
+    if constexpr (requires { result.append(std::move(*it)); }) {
+      result.append(std::move(*it));
+    } else {
+      result.insert(result.end(), std::make_move_iterator(it->begin()), std::make_move_iterator(it->end()));
+    }
+  }
+  return result;
+}
+
+#endif // AOC2020_CHUNKED_PARSE_
@@ -1,44 +1,191 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "options.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
-#include <unordered_set>
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
 
-std::unordered_set<int> parse(std::istream&& is)
+namespace {
+
+std::vector<long long> parse(const MappedInput &input)
 {
-  std::unordered_set<int> result;
-  int el;
-  while (is >> el) {
-    result.insert(el);
+  std::vector<long long> result;
+  result.reserve(input.line_count());
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty();) {
+    result.push_back(scanner.number<long long>());
   }
   return result;
 }
 
-int main(int argc, char** argv)
+// Answers "which k entries sum to the target" queries against one expense
+// list. Entries are kept sorted and the last two entries of a combination
+// come from a two-pointer sweep, so a query for k entries costs O(n^(k-1)).
+// Batches of queries first build a sorted table of all pair sums (meet in the
+// middle) when it fits in memory, which brings each query to
+// O(n^(k-2) log n).
+class ExpenseReport
 {
-  const auto data = parse(load_input(argc, argv));
+public:
+  explicit ExpenseReport(std::vector<long long> entries)
+    : m_entries{ std::move(entries) }
+  {
+    std::sort(m_entries.begin(), m_entries.end());
+  }
+
+  // Entries at k distinct positions, in ascending order, summing to the
+  // target; nullopt if there are none.
+  std::optional<std::vector<long long>> find_sum(long long target, std::size_t k) const
+  {
+    return find_sum(target, k, {});
+  }
+
+  // Batch mode: answers every target against the same sorted entries and
+  // pair table.
+  std::vector<std::optional<std::vector<long long>>> find_sums(std::span<const long long> targets, std::size_t k) const
+  {
+    const auto pairs = targets.size() > 1 && k >= 2 ? pair_sums() : std::vector<Pair>{};
+    std::vector<std::optional<std::vector<long long>>> results;
+    results.reserve(targets.size());
+    for (const auto target : targets) {
+      results.push_back(find_sum(target, k, pairs));
+    }
+    return results;
+  }
+
+private:
+  struct Pair
+  {
+    long long sum;
+    std::uint32_t first;
+    std::uint32_t second;
+  };
+
+  static constexpr std::size_t max_pairs = std::size_t{ 1 } << 22;
 
-  const auto part1 = [&] {
-    for (auto e : data) {
-      if (data.contains(2020 - e)) {
-        return e * (2020 - e);
+  // All pairs ordered by sum, then by first position; empty if too large.
+  std::vector<Pair> pair_sums() const
+  {
+    std::vector<Pair> pairs;
+    const auto n = m_entries.size();
+    if (n < 2 || n * (n - 1) / 2 > max_pairs) return pairs;
+    pairs.reserve(n * (n - 1) / 2);
+    for (std::uint32_t i = 0; i < n; ++i) {
+      for (std::uint32_t j = i + 1; j < n; ++j) {
+        pairs.push_back(Pair{ m_entries[i] + m_entries[j], i, j });
       }
     }
-    return -1;
-  }();
-  fmt::print("Part 1: {}\n", part1);
-
-  const auto part2 = [&] {
-    for (auto e : data) {
-      for (auto f : data | ranges::views::drop(1)) {
-        const auto residual = 2020 - e - f;
-        if (data.find(residual) != data.end()) {
-          return residual * e * f;
-        }
+    std::sort(pairs.begin(), pairs.end(), [](const auto &l, const auto &r) {
+      return std::tie(l.sum, l.first) < std::tie(r.sum, r.first);
+    });
+    return pairs;
+  }
+
+  std::optional<std::vector<long long>> find_sum(long long target, std::size_t k, std::span<const Pair> pairs) const
+  {
+    std::vector<long long> chosen;
+    chosen.reserve(k);
+    if (k == 0 || k > m_entries.size() || !find(target, k, 0, pairs, chosen)) return std::nullopt;
+    return chosen;
+  }
+
+  // Chooses k entries among positions >= first, appending them to chosen.
+  bool find(long long target, std::size_t k, std::size_t first, std::span<const Pair> pairs, std::vector<long long> &chosen) const
+  {
+    const auto n = m_entries.size();
+    if (n - first < k) return false;
+    if (k == 1) return find_one(target, first, chosen);
+    if (k == 2) return pairs.empty() ? find_two_pointer(target, first, chosen) : find_pair(target, first, pairs, chosen);
+
+    for (auto i = first; i + k <= n; ++i) {
+      // The entries are sorted, so the smallest and largest sums reachable
+      // from here bound the search.
+      const auto smallest = std::accumulate(m_entries.begin() + i, m_entries.begin() + i + k, 0ll);
+      if (smallest > target) break;
+      const auto largest = m_entries[i] + std::accumulate(m_entries.end() - (k - 1), m_entries.end(), 0ll);
+      if (largest < target) continue;
+
+      chosen.push_back(m_entries[i]);
+      if (find(target - m_entries[i], k - 1, i + 1, pairs, chosen)) return true;
+      chosen.pop_back();
+    }
+    return false;
+  }
+
+  bool find_one(long long target, std::size_t first, std::vector<long long> &chosen) const
+  {
+    const auto it = std::lower_bound(m_entries.begin() + first, m_entries.end(), target);
+    if (it == m_entries.end() || *it != target) return false;
+    chosen.push_back(target);
+    return true;
+  }
+
+  bool find_two_pointer(long long target, std::size_t first, std::vector<long long> &chosen) const
+  {
+    auto lo = first;
+    auto hi = m_entries.size() - 1;
+    while (lo < hi) {
+      const auto sum = m_entries[lo] + m_entries[hi];
+      if (sum == target) {
+        chosen.push_back(m_entries[lo]);
+        chosen.push_back(m_entries[hi]);
+        return true;
       }
+      sum < target ? ++lo : --hi;
     }
-    return -1;
-  }();
-  fmt::print("Part 2: {}\n", part2);
-}
\ No newline at end of file
+    return false;
+  }
+
+  // Pairs with equal sums are ordered by their first position, so the
+  // first pair that starts at or after `first` is found by one search.
+  bool find_pair(long long target, std::size_t first, std::span<const Pair> pairs, std::vector<long long> &chosen) const
+  {
+    const auto it = std::lower_bound(pairs.begin(), pairs.end(), std::pair{ target, first }, [](const Pair &p, const auto &key) {
+      return p.sum < key.first || (p.sum == key.first && p.first < key.second);
+    });
+    if (it == pairs.end() || it->sum != target) return false;
+    chosen.push_back(m_entries[it->first]);
+    chosen.push_back(m_entries[it->second]);
+    return true;
+  }
+
+  std::vector<long long> m_entries;
+};
+
+// Products of the k entries summing to each target, comma-separated; -1
+// where there are none.
+std::string products_of_sums(const ExpenseReport &report, std::span<const long long> targets, std::size_t k)
+{
+  std::string result;
+  for (const auto &entries : report.find_sums(targets, k)) {
+    if (!result.empty()) result += ',';
+    result += fmt::format("{}", entries ? ranges::accumulate(*entries, 1ll, std::multiplies{}) : -1);
+  }
+  return result;
+}
+
+}// namespace
+
+Answers day1(const std::filesystem::path &input)
+{
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto report = timed("parse", [&] { return ExpenseReport{ parse(buffer) }; });
+  // Several targets are answered as one batch against the same report.
+  const auto targets = option_list("DAY1_TARGETS", std::vector{ option("DAY1_TARGET", 2020ll) });
+  const auto part1_entries = option("DAY1_PART1_ENTRIES", std::size_t{ 2 });
+  const auto part2_entries = option("DAY1_PART2_ENTRIES", std::size_t{ 3 });
+
+  answers.part1 = timed("part 1", [&] { return products_of_sums(report, targets, part1_entries); });
+  answers.part2 = timed("part 2", [&] { return products_of_sums(report, targets, part2_entries); });
+  return answers;
+}
@@ -1,64 +1,142 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "options.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
-#include <unordered_set>
-#include <unordered_map>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
-std::unordered_set<int> parse(std::istream &&is)
+namespace {
+
+// Adapter ratings in increasing order, with the outlet's 0 in front.
+std::vector<int> parse(const MappedInput &input)
 {
-  std::unordered_set<int> result;
-  int el;
-  while (is >> el) {
-    result.insert(el);
+  std::vector<int> result{ 0 };
+  result.reserve(input.line_count() + 1);
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty();) {
+    result.push_back(scanner.number<int>());
   }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  if (result.front() < 0) throw std::runtime_error{ "Negative adapter rating" };
   return result;
 }
 
-// Max is at most 3*N, so this is O(N)
-std::array<int, 3> count_gaps(const std::unordered_set<int>& data, int max)
+// Histogram of the differences along the chain, the device's final gap
+// included; throws if two neighbours are further apart than max_gap.
+std::vector<long long> count_gaps(const std::vector<int> &chain, int max_gap)
 {
-  std::array<int, 3> gaps{ 0 };
-  int current = 0;
-  for (int i = 1; i <= max; ++i) {
-    if (data.contains(i)) {
-      ++gaps[i - current - 1];
-      current = i;
-    }
+  std::vector<long long> gaps(max_gap + 1);
+  for (std::size_t i = 1; i < chain.size(); ++i) {
+    const auto gap = chain[i] - chain[i - 1];
+    if (gap > max_gap) throw std::runtime_error{ fmt::format("No adapter between {} and {}", chain[i - 1], chain[i]) };
+    ++gaps[gap];
   }
-  // Add the last gap of size 3
-  ++gaps[2];
+  ++gaps[max_gap];
   return gaps;
 }
 
-long long n_arrangements(const std::unordered_set<int> &data, int max)
+// Unsigned integer of any size, with just what counting arrangements needs:
+// addition and decimal output. Limbs are 64-bit, least significant first.
+class BigCount
+{
+public:
+  BigCount() = default;
+
+  explicit BigCount(std::uint64_t value)
+  {
+    if (value != 0) m_limbs.push_back(value);
+  }
+
+  // Sets the value to zero, keeping the storage.
+  void clear()
+  {
+    m_limbs.clear();
+  }
+
+  BigCount &operator+=(const BigCount &other)
+  {
+    if (other.m_limbs.size() > m_limbs.size()) m_limbs.resize(other.m_limbs.size(), 0);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < m_limbs.size(); ++i) {
+      if (i >= other.m_limbs.size() && carry == 0) break;
+      const auto addend = i < other.m_limbs.size() ? other.m_limbs[i] : 0;
+      const auto sum = m_limbs[i] + addend;
+      m_limbs[i] = sum + carry;
+      carry = (sum < addend) | (m_limbs[i] < sum);
+    }
+    if (carry != 0) m_limbs.push_back(carry);
+    return *this;
+  }
+
+  std::string to_string() const
+  {
+    constexpr std::uint64_t base = 1'000'000'000'000'000'000ull;
+    auto limbs = m_limbs;
+    std::vector<std::uint64_t> digits;
+    while (!limbs.empty()) {
+      unsigned __int128 remainder = 0;
+      for (auto i = limbs.size(); i-- > 0;) {
+        const auto current = (remainder << 64) | limbs[i];
+        limbs[i] = static_cast<std::uint64_t>(current / base);
+        remainder = current % base;
+      }
+      digits.push_back(static_cast<std::uint64_t>(remainder));
+      while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+    }
+    if (digits.empty()) return "0";
+
+    auto result = fmt::format("{}", digits.back());
+    for (auto i = digits.size() - 1; i-- > 0;) {
+      result += fmt::format("{:018}", digits[i]);
+    }
+    return result;
+  }
+
+private:
+  std::vector<std::uint64_t> m_limbs;
+};
+
+// Ways to reach each adapter are the sum of the ways to reach the adapters
+// at most max_gap below it. Ratings are distinct, so those are among the
+// max_gap previous entries of the chain, and only that many counts are
+// kept, in a ring. The device is max_gap above the last adapter, so it is
+// reached exactly as often as the last adapter.
+BigCount n_arrangements(const std::vector<int> &chain, int max_gap)
 {
-  std::unordered_map<int, long long> cache;
-  cache.emplace(max, 1ll);
-  const auto impl = [&](auto &&f, int index) {
-    if (const auto it = cache.find(index); it != cache.cend()) {
-      return it->second;
-    } else {
-      const auto value = ranges::accumulate(
-        ranges::views::iota(index + 1, std::min(max, index + 3) + 1)
-          | ranges::views::filter([&](auto i) { return data.contains(i); })
-          | ranges::views::transform([&](auto i) { return f(f, i); }),
-        0ll
-      );
-      cache.emplace(index, value);
-      return value;
+  const auto ring_size = static_cast<std::size_t>(max_gap) + 1;
+  std::vector<BigCount> ways(ring_size);
+  ways[0] = BigCount{ 1 };
+  for (std::size_t i = 1; i < chain.size(); ++i) {
+    auto &current = ways[i % ring_size];
+    current.clear();
+    for (auto j = i; j-- > 0 && i - j < ring_size && chain[i] - chain[j] <= max_gap;) {
+      current += ways[j % ring_size];
     }
-  };
-  return impl(impl, 0);
+  }
+  return ways[(chain.size() - 1) % ring_size];
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day10(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto chain = timed("parse", [&] { return parse(buffer); });
+  const auto max_gap = option("DAY10_MAX_GAP", 3);
+  if (max_gap < 1) throw std::invalid_argument{ "AOC_DAY10_MAX_GAP must be positive" };
 
-  const auto max = *ranges::max_element(data);
-  const auto gaps = count_gaps(data, max);
-  fmt::print("Part 1: {}\n", gaps[0] * gaps[2]);
-  fmt::print("Part 2: {}\n", n_arrangements(data, max));
-}
\ No newline at end of file
+  answers.part1 = timed("part 1", [&] {
+    const auto gaps = count_gaps(chain, max_gap);
+    return fmt::format("{}", gaps[1] * gaps[max_gap]);
+  });
+  answers.part2 = timed("part 2", [&] { return n_arrangements(chain, max_gap).to_string(); });
+  return answers;
+}
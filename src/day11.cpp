@@ -1,9 +1,20 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 #include "padded_vector_2d.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
 #include <utility>
+#include <vector>
+
+namespace {
 
 enum class SeatState {
   Empty,
@@ -21,86 +32,186 @@ PaddedVector2D<SeatState> parse(std::istream &&is) {
       std::back_inserter(result),
       [](char c) { return c == 'L' ? SeatState::Empty : SeatState::Missing; });
   }
-  
-  return PaddedVector2D{ column_size, SeatState::Empty, std::move(result) };
+
+  return PaddedVector2D{ column_size, SeatState::Missing, std::move(result) };
 }
 
-constexpr std::array neighbours {
-  std::pair{-1, -1},
-  std::pair{-1, 0},
-  std::pair{-1, 1},
-  std::pair{0, -1},
-  std::pair{0, 1},
-  std::pair{1, -1},
-  std::pair{1, 0},
-  std::pair{1, 1},
+// Seats visible from every seat in compressed sparse row form: seats are
+// numbered in row-major order and those visible from seat i are
+// seats[offsets[i]] up to seats[offsets[i + 1]], at most eight.
+struct VisibleSeats
+{
+  std::vector<std::uint32_t> offsets;
+  std::vector<std::uint32_t> seats;
 };
 
-constexpr auto count_neighbours_1 = [](const PaddedVector2D<SeatState>& data, int row, int column)
+// Visibility is symmetric, so one row-major sweep that remembers the last
+// seat seen to the left, above and on both diagonals above finds every
+// pair once, in time linear in the grid.
+VisibleSeats visible_seats(const PaddedVector2D<SeatState> &layout)
 {
-  return ranges::count(
-    neighbours
-      | ranges::views::transform([&data, row, column](auto p) { return data.at(p.first + row, p.second + column); }),
-    SeatState::Occupied);
-};
+  constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+  const auto n_rows = layout.rows();
+  const auto n_cols = layout.cols();
+  std::vector<std::uint32_t> up(n_cols, none);
+  std::vector<std::uint32_t> up_left(n_rows + n_cols, none);
+  std::vector<std::uint32_t> up_right(n_rows + n_cols, none);
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+  std::uint32_t n_seats = 0;
+  for (std::size_t row = 0; row < n_rows; ++row) {
+    auto left = none;
+    const auto cells = layout.row(static_cast<int>(row));
+    for (std::size_t column = 0; column < n_cols; ++column) {
+      if (cells[column] == SeatState::Missing) continue;
+      const auto seat = n_seats++;
+      auto &diagonal = up_left[row + n_cols - 1 - column];
+      auto &anti_diagonal = up_right[row + column];
+      for (const auto other : { left, up[column], diagonal, anti_diagonal }) {
+        if (other != none) pairs.emplace_back(other, seat);
+      }
+      left = up[column] = diagonal = anti_diagonal = seat;
+    }
+  }
 
-constexpr auto next_state_1 = [](SeatState old, int neighbours) {
-  if (old == SeatState::Occupied && neighbours >= 4)
-    return SeatState::Empty;
-  else if (old == SeatState::Empty && neighbours == 0)
-    return SeatState::Occupied;
-  else
-    return old;
-};
+  VisibleSeats visible;
+  visible.offsets.assign(n_seats + 1, 0);
+  for (const auto &[a, b] : pairs) {
+    ++visible.offsets[a + 1];
+    ++visible.offsets[b + 1];
+  }
+  std::partial_sum(visible.offsets.begin(), visible.offsets.end(), visible.offsets.begin());
+  visible.seats.resize(visible.offsets.back());
+  auto fill = visible.offsets;
+  for (const auto &[a, b] : pairs) {
+    visible.seats[fill[a]++] = b;
+    visible.seats[fill[b]++] = a;
+  }
+  return visible;
+}
 
-constexpr auto count_neighbours_2 = [](const PaddedVector2D<SeatState>& data, int row, int column)
+// Runs the rules until nothing changes, with a seat emptying at `crowded`
+// or more occupied neighbours. Neighbour counts are updated when a seat
+// flips, and only seats next to a flip are evaluated in the following
+// step; the others keep their state, as their counts did not change.
+std::size_t simulate_visible(const VisibleSeats &visible, int crowded)
 {
-  return ranges::count(
-    neighbours
-      | ranges::views::transform([&data, row, column](auto p) { 
-          auto r = p.first + row;
-          auto c = p.second + column;
-          while (data.at(r, c) == SeatState::Missing) {
-            r += p.first;
-            c += p.second;
-          }
-          return data.at(r, c);
-      }),
-    SeatState::Occupied);
-};
+  const auto n_seats = visible.offsets.size() - 1;
+  std::vector<std::uint8_t> occupied(n_seats, 0);
+  std::vector<std::uint8_t> n_occupied(n_seats, 0);
+  std::vector<std::uint32_t> dirty(n_seats);
+  std::iota(dirty.begin(), dirty.end(), 0u);
+  std::vector<std::uint32_t> queued(n_seats, 0);
+  std::vector<std::uint32_t> flipped;
+  std::vector<std::uint32_t> next_dirty;
+
+  for (std::uint32_t step = 1; !dirty.empty(); ++step) {
+    flipped.clear();
+    for (const auto seat : dirty) {
+      if (occupied[seat] ? n_occupied[seat] >= crowded : n_occupied[seat] == 0) flipped.push_back(seat);
+    }
 
-constexpr auto next_state_2 = [](SeatState old, int neighbours) {
-  if (old == SeatState::Occupied && neighbours >= 5)
-    return SeatState::Empty;
-  else if (old == SeatState::Empty && neighbours == 0)
-    return SeatState::Occupied;
-  else
-    return old;
+    next_dirty.clear();
+    for (const auto seat : flipped) {
+      occupied[seat] ^= 1;
+      for (auto edge = visible.offsets[seat]; edge < visible.offsets[seat + 1]; ++edge) {
+        const auto neighbour = visible.seats[edge];
+        occupied[seat] ? ++n_occupied[neighbour] : --n_occupied[neighbour];
+        if (queued[neighbour] != step) {
+          queued[neighbour] = step;
+          next_dirty.push_back(neighbour);
+        }
+      }
+    }
+    std::swap(dirty, next_dirty);
+  }
+  return static_cast<std::size_t>(std::count(occupied.begin(), occupied.end(), 1));
+}
+
+using SeatPlane = PaddedVector2D<bool>;
+using word_t = SeatPlane::word_t;
+
+// Seats of the layout as one bit per cell.
+SeatPlane seat_plane(const PaddedVector2D<SeatState> &layout)
+{
+  SeatPlane seats{ layout.rows(), layout.cols(), false };
+  for (std::size_t row = 0; row < layout.rows(); ++row) {
+    const auto cells = layout.row(static_cast<int>(row));
+    auto words = seats.row_words(row);
+    for (std::size_t column = 0; column < cells.size(); ++column) {
+      words[column / SeatPlane::word_bits] |= word_t{ cells[column] != SeatState::Missing } << (column % SeatPlane::word_bits);
+    }
+  }
+  return seats;
+}
+
+struct NeighbourCounts
+{
+  // Seats with no occupied neighbour.
+  word_t none;
+  // Seats with four or more.
+  word_t at_least_four;
 };
 
-template <auto next_state, auto count_neighbours>
-PaddedVector2D<SeatState> simulate_until_steady(PaddedVector2D<SeatState> arrangement)
+// Adds eight one-bit planes with carry-save adders: bit i of the result
+// describes the sum of bit i of the inputs, for 64 seats at once.
+NeighbourCounts count_occupied(const std::array<word_t, 8> &n)
+{
+  const auto full_add = [](word_t a, word_t b, word_t c) {
+    return std::pair{ a ^ b ^ c, (a & b) | (c & (a ^ b)) };
+  };
+  const auto [ones_a, twos_a] = full_add(n[0], n[1], n[2]);
+  const auto [ones_b, twos_b] = full_add(n[3], n[4], n[5]);
+  const auto ones_c = n[6] ^ n[7];
+  const auto twos_c = n[6] & n[7];
+  const auto [ones, twos_d] = full_add(ones_a, ones_b, ones_c);
+  const auto [twos_e, fours_a] = full_add(twos_a, twos_b, twos_c);
+  const auto twos = twos_e ^ twos_d;
+  const auto fours_b = twos_e & twos_d;
+  // fours_a and fours_b are both set only for a count of eight.
+  const auto at_least_four = fours_a | fours_b;
+  return NeighbourCounts{ ~(ones | twos | at_least_four), at_least_four };
+}
+
+// Part 1 rules on whole words of seats: the eight neighbour planes of a
+// word are the rows above, at and below shifted by one column, with the
+// bits that cross a word boundary taken from the adjacent word.
+std::size_t simulate_bitsliced(const SeatPlane &seats)
 {
-  int diff = 0;
-  auto old = arrangement;
-  do {
-    diff = 0;
-    for (int row = 0; row < arrangement.rows(); ++row) {
-      for (int column = 0; column < arrangement.cols(); ++column) {
-        const auto old_value = old.at(row, column);
-        const auto new_value = next_state(old_value, count_neighbours(old, row, column));
-        if (old_value != new_value) { ++diff; }
-        arrangement.at(row, column) = new_value;
+  constexpr auto top_bit = SeatPlane::word_bits - 1;
+  const auto words_per_row = seats.words_per_row();
+  SeatPlane occupied{ seats.rows(), seats.cols(), false };
+  auto next = occupied;
+  const std::vector<word_t> empty_row(words_per_row, 0);
+
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (std::size_t row = 0; row < seats.rows(); ++row) {
+      const auto above = row > 0 ? occupied.row_words(row - 1) : std::span<const word_t>{ empty_row };
+      const auto current = std::as_const(occupied).row_words(row);
+      const auto below = row + 1 < seats.rows() ? occupied.row_words(row + 1) : std::span<const word_t>{ empty_row };
+      const auto seat_words = seats.row_words(row);
+      const auto out = next.row_words(row);
+      for (std::size_t i = 0; i < words_per_row; ++i) {
+        const auto left = [&](std::span<const word_t> r) { return (r[i] << 1) | (i > 0 ? r[i - 1] >> top_bit : 0); };
+        const auto right = [&](std::span<const word_t> r) { return (r[i] >> 1) | (i + 1 < words_per_row ? r[i + 1] << top_bit : 0); };
+        const auto counts = count_occupied({ left(above), above[i], right(above), left(current), right(current), left(below), below[i], right(below) });
+        const auto value = seat_words[i] & (counts.none | (current[i] & ~counts.at_least_four));
+        changed = changed || value != current[i];
+        out[i] = value;
       }
     }
-    std::swap(arrangement, old);
-  } while (diff > 0);
-  return old;
+    std::swap(occupied, next);
+  }
+  return occupied.count();
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day11(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", ranges::count(simulate_until_steady<next_state_1, count_neighbours_1>(data).raw(), SeatState::Occupied));
-  fmt::print("Part 2: {}\n", ranges::count(simulate_until_steady<next_state_2, count_neighbours_2>(data).raw(), SeatState::Occupied));
-}
\ No newline at end of file
+  Answers answers;
+  const auto data = timed("parse", [&] { return parse(load_input(input)); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", simulate_bitsliced(seat_plane(data))); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", simulate_visible(visible_seats(data), 5)); });
+  return answers;
+}
@@ -1,4 +1,6 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -7,6 +9,8 @@
 #include <charconv>
 #include <exception>
 
+namespace {
+
 struct Instruction
 {
   char type;
@@ -114,9 +118,13 @@ Position execute_part_2(const std::vector<Instruction>& is) {
   }).first;
 }
 
-int main(int argc, char** argv)
+}// namespace
+
+Answers day12(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", length(execute_part_1(data)));
-  fmt::print("Part 2: {}\n", length(execute_part_2(data)));
+  Answers answers;
+  const auto data = timed("parse", [&] { return parse(load_input(input)); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", length(execute_part_1(data))); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", length(execute_part_2(data))); });
+  return answers;
 }
@@ -1,4 +1,6 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -8,6 +10,8 @@
 #include <numeric>
 #include <concepts>
 
+namespace {
+
 std::optional<int> to_int(std::string_view str)
 {
   int result;
@@ -107,11 +111,16 @@ long long solve_crt(const std::vector<Equation> &equations)
   return ranges::accumulate(prods, 0ll) % prod;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day13(const std::filesystem::path &input)
 {
-  const auto [timestamp, buses] = parse(load_input(argc, argv));
-  const auto [bus, wait_time] = first_bus(timestamp, buses);
-  fmt::print("Part 1: {}\n", bus * wait_time);
-  const auto equations = extract_crt(buses);
-  fmt::print("Part 2: {}\n", solve_crt(equations));
+  Answers answers;
+  const auto [timestamp, buses] = timed("parse", [&] { return parse(load_input(input)); });
+  answers.part1 = timed("part 1", [&] {
+    const auto [bus, wait_time] = first_bus(timestamp, buses);
+    return fmt::format("{}", bus * wait_time);
+  });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", solve_crt(extract_crt(buses))); });
+  return answers;
 }
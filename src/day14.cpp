@@ -1,12 +1,14 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <unordered_map>
 #include <bitset>
-#include <regex>
 
-static const std::regex mem_line{ R"(mem\[(\d+)\] = (\d+))"};
+namespace {
 
 struct Instruction
 {
@@ -30,21 +32,26 @@ std::pair<std::bitset<36>, std::bitset<36>> parse_mask(std::string_view str)
   return std::pair{ mask, float_mask };
 }
 
-std::vector<Instruction> parse(std::istream&& is)
+std::vector<Instruction> parse(const MappedInput &input)
 {
   std::vector<Instruction> instructions;
+  instructions.reserve(input.line_count());
   std::bitset<36> mask;
   std::bitset<36> float_mask;
 
-  for (std::string d; std::getline(is, d);) {
-    if (d.starts_with("mask = ")) {
-      std::tie(mask, float_mask) = parse_mask(std::string_view{ d.begin() + 7, d.begin() + 7 + 36 });
-    } else {
-      std::smatch match;
-      if (!std::regex_match(d, match, mem_line)) {
-        throw std::runtime_error{ "Mismatch in memory input" };
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty();) {
+    if (scanner.consume("mask = ")) {
+      const auto bits = scanner.line();
+      if (bits.size() != 36) {
+        throw std::runtime_error{ "Mismatch in mask input" };
       }
-      instructions.emplace_back(std::stoull(match[1]), std::stoull(match[2]), mask, float_mask);
+      std::tie(mask, float_mask) = parse_mask(bits);
+    } else {
+      scanner.expect("mem[");
+      const auto addr = scanner.number<std::uint64_t>();
+      scanner.expect("] = ");
+      const auto value = scanner.number<std::uint64_t>();
+      instructions.emplace_back(addr, value, mask, float_mask);
     }
   }
   return instructions;
@@ -87,9 +94,14 @@ std::uint64_t part_2(const std::vector<Instruction>& program) {
   );
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day14(const std::filesystem::path &input)
 {
-  const auto program = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", part_1(program));
-  fmt::print("Part 2: {}\n", part_2(program));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto program = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", part_1(program)); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", part_2(program)); });
+  return answers;
 }
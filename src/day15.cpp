@@ -1,14 +1,20 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "options.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <unordered_map>
 
-std::vector<int> parse(std::istream &&is)
+namespace {
+
+std::vector<int> parse(const MappedInput &input)
 {
   std::vector<int> result;
-  for (std::string d; std::getline(is, d, ',');) {
-    result.push_back(std::stoi(d));
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty(); scanner.consume(',')) {
+    result.push_back(scanner.number<int>());
   }
   return result;
 }
@@ -35,9 +41,14 @@ int nth_called(const std::vector<int>& start, int n) {
   return current;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day15(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", nth_called(data, 2020));
-  fmt::print("Part 2: {}\n", nth_called(data, 30'000'000));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto data = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", nth_called(data, 2020)); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", nth_called(data, option("DAY15_TURNS", 30'000'000))); });
+  return answers;
 }
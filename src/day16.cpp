@@ -1,14 +1,18 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
+#include <string_view>
 #include <utility>
-#include <charconv>
-#include <regex>
+
+namespace {
 
 struct Field
 {
-  std::string name;
+  std::string_view name;
   std::pair<int, int> interval1;
   std::pair<int, int> interval2;
 };
@@ -21,54 +25,40 @@ bool verify(const Field& field, int value) {
   return verify(field.interval1, value) || verify(field.interval2, value);
 }
 
-static const std::regex field_regex { R"(([^:]+): (\d+)-(\d+) or (\d+)-(\d+))" };
-
 using ticket_t = std::vector<int>;
 
-int to_int(std::string_view sv) {
-  int i;
-  std::from_chars(sv.data(), sv.data() + sv.size(), i);
-  return i;
-}
-
-ticket_t parse_ticket(const std::string& ticket) {
+ticket_t parse_ticket(std::string_view ticket) {
   ticket_t result;
-  auto begin = ticket.cbegin();
-  for (;;) {
-    const auto end = std::find(begin + 1, ticket.cend(), ',');
-    result.push_back(to_int(std::string_view(begin, end)));
-    if (end != ticket.cend()) {
-      begin = end + 1;
-    } else {
-      break;
-    }
-  };
+  for (Scanner scanner{ ticket }; !scanner.empty(); scanner.consume(',')) {
+    result.push_back(scanner.number<int>());
+  }
   return result;
 }
 
-std::tuple<std::vector<Field>, ticket_t, std::vector<ticket_t>> parse(std::istream &&is)
+std::pair<int, int> parse_interval(Scanner &scanner) {
+  const auto first = scanner.number<int>();
+  scanner.expect("-");
+  return std::pair{ first, scanner.number<int>() };
+}
+
+std::tuple<std::vector<Field>, ticket_t, std::vector<ticket_t>> parse(const MappedInput &input)
 {
   std::vector<Field> fields;
-  ticket_t my_ticket;
   std::vector<ticket_t> tickets;
-  for (std::string line; std::getline(is, line) && !line.empty();) {
-    std::smatch match;
-    if (std::regex_match(line, match, field_regex)) {
-      fields.emplace_back(
-          match[1],
-          std::pair{ std::stoi(match[2]), std::stoi(match[3]) },
-          std::pair{ std::stoi(match[4]), std::stoi(match[5]) });
-    }
+  Scanner scanner{ input.view() };
+  for (auto line = scanner.line(); !line.empty(); line = scanner.line()) {
+    Scanner field{ line };
+    const auto name = field.until(':');
+    field.expect(" ");
+    const auto interval1 = parse_interval(field);
+    field.expect(" or ");
+    fields.emplace_back(name, interval1, parse_interval(field));
   }
-  is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  {
-    std::string line;
-    std::getline(is, line);
-    my_ticket = parse_ticket(line);
-  }
-  is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  for (std::string line; std::getline(is, line) && !line.empty();) {
+  scanner.expect("your ticket:\n");
+  auto my_ticket = parse_ticket(scanner.line());
+  scanner.skip_whitespace();
+  scanner.expect("nearby tickets:\n");
+  for (auto line = scanner.line(); !line.empty(); line = scanner.line()) {
     tickets.push_back(parse_ticket(line));
   }
   return std::tuple{ std::move(fields), std::move(my_ticket), std::move(tickets) };
@@ -120,23 +110,30 @@ std::vector<std::int8_t> extract_column(std::vector<std::vector<std::int8_t>> co
   return result;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day16(const std::filesystem::path &input)
 {
-  const auto [fields, my_ticket, values] = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", ticket_scanning_error(fields, values));
-
-  auto tickets = values
-                 | ranges::views::filter([&](const auto &vs) { return is_valid(fields, vs); })
-                 | ranges::to<std::vector>;
-  const auto columns = extract_column(extract_possible(fields, tickets));
-  fmt::print(
-    "Part 2: {}\n",
-    ranges::accumulate(
-      ranges::views::zip(fields | ranges::views::transform(&Field::name), columns)
-        | ranges::views::filter([](const auto &el) { return el.first.starts_with("departure"); })
-        | ranges::views::transform([&](const auto &el) { return my_ticket[el.second]; }),
-      1ll,
-      std::multiplies{}
-    )
-  );
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto [fields, my_ticket, values] = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", ticket_scanning_error(fields, values)); });
+
+  answers.part2 = timed("part 2", [&] {
+    auto tickets = values
+                   | ranges::views::filter([&](const auto &vs) { return is_valid(fields, vs); })
+                   | ranges::to<std::vector>;
+    const auto columns = extract_column(extract_possible(fields, tickets));
+    return fmt::format(
+      "{}",
+      ranges::accumulate(
+        ranges::views::zip(fields | ranges::views::transform(&Field::name), columns)
+          | ranges::views::filter([](const auto &el) { return el.first.starts_with("departure"); })
+          | ranges::views::transform([&](const auto &el) { return my_ticket[el.second]; }),
+        1ll,
+        std::multiplies{}
+      )
+    );
+  });
+  return answers;
 }
@@ -1,4 +1,6 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -7,6 +9,8 @@
 #include <unordered_set>
 #include <unordered_map>
 
+namespace {
+
 template<typename T>
 inline constexpr void hash_combine(std::size_t &s, const T &v)
 {
@@ -14,6 +18,8 @@ inline constexpr void hash_combine(std::size_t &s, const T &v)
   s ^= std::hash<T>()(v) + 0x9e3779b9 + (s << 6) + (s >> 2);
 };
 
+}// namespace
+
 namespace std {
 
 template<typename... Ts>
@@ -29,6 +35,8 @@ struct hash<std::tuple<Ts...>>
 
 } // namespace std
 
+namespace {
+
 using quarternion_t = std::tuple<int, int, int, int>;
 
 std::unordered_set<quarternion_t> parse(std::istream &&is) {
@@ -83,16 +91,16 @@ static constexpr std::array<quarternion_t, (3 * 3 * 3 * 3) - 1> neighbours_4d =
   return result;
 }();
 
-template <int N>
+template <std::size_t N>
 std::unordered_set<quarternion_t> step(const std::unordered_set<quarternion_t>& prev, const std::array<quarternion_t, N>& neighbours) {
   std::unordered_map<quarternion_t, int> map;
-  for (const auto p : prev) {
-    for (const auto n : neighbours) {
+  for (const auto &p : prev) {
+    for (const auto &n : neighbours) {
       map[n + p] += 1;
     }
   }
   std::unordered_set<quarternion_t> result;
-  for (const auto [p, count] : map) {
+  for (const auto &[p, count] : map) {
     if (bool active = prev.contains(p); (active && (count == 2 || count == 3)) || (!active && count == 3)) {
       result.insert(p);
     }
@@ -100,19 +108,27 @@ std::unordered_set<quarternion_t> step(const std::unordered_set<quarternion_t>&
   return result;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day17(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
+  Answers answers;
+  const auto data = timed("parse", [&] { return parse(load_input(input)); });
 
-  auto prop_3d = data;
-  for (int i = 0; i < 6; ++i) {
-    prop_3d = step(prop_3d, neighbours_3d);
-  }
-  fmt::print("Part 1: {}\n", prop_3d.size());
+  answers.part1 = timed("part 1", [&] {
+    auto prop_3d = data;
+    for (int i = 0; i < 6; ++i) {
+      prop_3d = step(prop_3d, neighbours_3d);
+    }
+    return fmt::format("{}", prop_3d.size());
+  });
 
-  auto prop_4d = data;
-  for (int i = 0; i < 6; ++i) {
-    prop_4d = step(prop_4d, neighbours_4d);
-  }
-  fmt::print("Part 2: {}\n", prop_4d.size());
+  answers.part2 = timed("part 2", [&] {
+    auto prop_4d = data;
+    for (int i = 0; i < 6; ++i) {
+      prop_4d = step(prop_4d, neighbours_4d);
+    }
+    return fmt::format("{}", prop_4d.size());
+  });
+  return answers;
 }
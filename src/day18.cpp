@@ -1,19 +1,30 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "record_stream.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <vector>
 #include <stack>
-#include <string>
+#include <string_view>
 
-std::vector<std::string> parse(std::istream &&is) {
-  std::vector<std::string> result;
-  for (std::string line; std::getline(is, line);) {
-    result.push_back(std::move(line));
+namespace {
+
+std::vector<std::string_view> parse_chunk(std::string_view chunk) {
+  std::vector<std::string_view> result;
+  for (Scanner scanner{ chunk }; !scanner.empty();) {
+    result.push_back(scanner.line());
   }
   return result;
 }
 
+std::vector<std::string_view> parse(const MappedInput &input) {
+  return parse_chunked(input.view(), parse_chunk);
+}
+
 long long evaluate(std::string_view expression, bool part_2 = false) {
   std::stack<char> operators;
   std::stack<long long> values;
@@ -60,17 +71,43 @@ long long evaluate(std::string_view expression, bool part_2 = false) {
   return values.top();
 }
 
-int main(int argc, char **argv)
+Answers stream(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  auto part_1 = ranges::accumulate(
-    data | ranges::views::transform([](const auto &ex) { return evaluate(ex, false); }),
-    0ll
-  );
-  fmt::print("Part 1: {}\n", part_1);
-  auto part_2 = ranges::accumulate(
-    data | ranges::views::transform([](const auto &ex) { return evaluate(ex, true); }),
-    0ll
-  );
-  fmt::print("Part 2: {}\n", part_2);
+  return timed("stream", [&] {
+    long long part1 = 0;
+    long long part2 = 0;
+    RecordStream records{ input };
+    while (const auto line = records.next()) {
+      if (line->empty()) continue;
+      part1 += evaluate(*line, false);
+      part2 += evaluate(*line, true);
+    }
+    return Answers{ fmt::format("{}", part1), fmt::format("{}", part2) };
+  });
+}
+
+}// namespace
+
+Answers day18(const std::filesystem::path &input)
+{
+  if (is_stdin(input)) return stream(input);
+
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto data = timed("parse", [&] { return parse(buffer); });
+  auto part_1 = timed("part 1", [&] {
+    return ranges::accumulate(
+      data | ranges::views::transform([](const auto &ex) { return evaluate(ex, false); }),
+      0ll
+    );
+  });
+  answers.part1 = fmt::format("{}", part_1);
+  auto part_2 = timed("part 2", [&] {
+    return ranges::accumulate(
+      data | ranges::views::transform([](const auto &ex) { return evaluate(ex, true); }),
+      0ll
+    );
+  });
+  answers.part2 = fmt::format("{}", part_2);
+  return answers;
 }
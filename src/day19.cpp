@@ -1,12 +1,17 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <vector>
-#include <string>
+#include <string_view>
 #include <variant>
 #include <unordered_map>
-#include <charconv>
+
+namespace {
 
 template<class... Ts>
 struct overloaded : Ts...
@@ -14,12 +19,6 @@ struct overloaded : Ts...
   using Ts::operator()...;
 };
 
-int to_int(std::string_view sv) {
-  int i;
-  std::from_chars(sv.data(), sv.data() + sv.size(), i);
-  return i;
-}
-
 using Rule = std::vector<int>;
 
 struct OrRule
@@ -32,27 +31,22 @@ using Node = std::variant<Rule, OrRule, char>;
 using RulesTree = std::unordered_map<int, Node>;
 
 std::pair<int, Node> parse_rule(std::string_view rule_text) {
-  auto column = ranges::find(rule_text.begin(), rule_text.end(), ':');
-  auto id = to_int(std::string_view{ rule_text.begin(), column });
-  if (*(column + 2) == '"') {
-    return { id, *(column + 3) };
+  Scanner scanner{ rule_text };
+  const auto id = to_number<int>(scanner.until(':'));
+  scanner.skip_whitespace();
+  if (scanner.consume('"')) {
+    return { id, scanner.peek() };
   }
   Rule l;
   Rule r;
   Rule *rule_ptr = &l;
 
-  auto begin = column + 2;
-  while (begin != rule_text.end()) {
-    const auto end = ranges::find(begin, rule_text.end(), ' ');
-    if (*begin == '|') {
+  while (!scanner.skip_whitespace().empty()) {
+    if (scanner.consume('|')) {
       rule_ptr = &r;
     } else {
-      rule_ptr->push_back(to_int(std::string_view(begin, end)));
+      rule_ptr->push_back(scanner.number<int>());
     }
-    if (end == rule_text.end()) {
-      break;
-    }
-    begin = end + 1;
   }
 
   if (r.empty()) {
@@ -62,18 +56,24 @@ std::pair<int, Node> parse_rule(std::string_view rule_text) {
   }
 }
 
-std::pair<RulesTree, std::vector<std::string>> parse(std::istream &&is)
+std::vector<std::string_view> parse_messages(std::string_view chunk)
+{
+  std::vector<std::string_view> messages;
+  for (Scanner scanner{ chunk }; !scanner.empty();) {
+    messages.push_back(scanner.line());
+  }
+  return messages;
+}
+
+std::pair<RulesTree, std::vector<std::string_view>> parse(const MappedInput &input)
 {
   RulesTree rules;
-  std::vector<std::string> messages;
-  for (std::string line; std::getline(is, line) && !line.empty();) {
+  Scanner scanner{ input.view() };
+  for (auto line = scanner.line(); !line.empty(); line = scanner.line()) {
     auto [id, rule] = parse_rule(line);
     rules[id] = std::move(rule);
   }
-  for (std::string line; std::getline(is, line);) {
-    messages.push_back(std::move(line));
-  }
-  return std::pair{ std::move(rules), std::move(messages) };
+  return std::pair{ std::move(rules), parse_chunked(scanner.rest(), parse_messages) };
 }
 
 std::vector<std::string_view> matches_impl(const RulesTree& tree, int node_id, std::string_view message) {
@@ -112,18 +112,25 @@ bool matches(const RulesTree &tree, std::string_view message)
   return ranges::any_of(matches_impl(tree, 0, message), &std::string_view::empty);
 }
 
-std::vector<std::string_view> test(std::string_view s) { return { s }; };
+}// namespace
 
-int main(int argc, char **argv)
+Answers day19(const std::filesystem::path &input)
 {
-  auto [rules, messages] = parse(load_input(argc, argv));
-  fmt::print(
-    "Part 1: {}\n",
-    ranges::count_if(messages, [&](const auto &msg) { return matches(rules, msg); }));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  auto [rules, messages] = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] {
+    return fmt::format(
+      "{}",
+      ranges::count_if(messages, [&](const auto &msg) { return matches(rules, msg); }));
+  });
 
   rules[8] = OrRule{ Rule{ 42 }, Rule{ 42, 8 } };
   rules[11] = OrRule{ Rule{ 42, 31 }, Rule{ 42, 11, 31 } };
-  fmt::print(
-    "Part 2: {}\n",
-    ranges::count_if(messages, [&](const auto &msg) { return matches(rules, msg); }));
+  answers.part2 = timed("part 2", [&] {
+    return fmt::format(
+      "{}",
+      ranges::count_if(messages, [&](const auto &msg) { return matches(rules, msg); }));
+  });
+  return answers;
 }
@@ -1,50 +1,174 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "record_stream.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
-#include <sstream>
-#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
 #include <tuple>
+#include <vector>
 
-std::vector<std::tuple<int, int, char, std::string>> parse(std::istream&& is)
-{
-  std::vector<std::tuple<int, int, char, std::string>> result;
-
-  int min;
-  int max;
-  char c;
-  std::string s;
-  for (std::string line; std::getline(is, line);) {
-    std::stringstream stream{ line };
-    stream >> min;
-    stream.ignore();
-    stream >> max;
-    stream.ignore();
-    stream >> c;
-    stream.ignore(2);
-    stream >> s;
-    result.push_back(std::tuple(min, max, c, s));
+namespace {
+
+using policy_t = std::tuple<int, int, char, std::string_view>;
+
+policy_t parse_policy(Scanner &scanner)
+{
+  const auto min = scanner.number<int>();
+  if (min < 1) throw std::runtime_error{ fmt::format("Invalid position {}", min) };
+  scanner.expect("-");
+  const auto max = scanner.number<int>();
+  scanner.skip(1);
+  const auto c = scanner.peek();
+  scanner.skip(3);
+  return policy_t{ min, max, c, scanner.line() };
+}
+
+// Policies stored column by column; passwords stay in the mapped input and
+// are referenced by offset and length, so parsing allocates only the columns.
+struct Policies
+{
+  std::vector<std::uint32_t> min;
+  std::vector<std::uint32_t> max;
+  std::vector<char> letter;
+  std::vector<std::size_t> offset;
+  std::vector<std::uint16_t> length;
+
+  std::size_t size() const
+  {
+    return letter.size();
+  }
+
+  void reserve(std::size_t n)
+  {
+    min.reserve(n);
+    max.reserve(n);
+    letter.reserve(n);
+    offset.reserve(n);
+    length.reserve(n);
+  }
+
+  void push_back(const policy_t &policy, std::size_t password_offset)
+  {
+    const auto &[lo, hi, c, s] = policy;
+    if (s.size() > UINT16_MAX) throw std::runtime_error{ fmt::format("Password of {} characters is too long", s.size()) };
+    min.push_back(static_cast<std::uint32_t>(lo));
+    // parse_policy rejects min < 1, and a max below that can never match.
+    max.push_back(static_cast<std::uint32_t>(std::max(hi, 0)));
+    letter.push_back(c);
+    offset.push_back(password_offset);
+    length.push_back(static_cast<std::uint16_t>(s.size()));
+  }
+
+  void append(Policies &&other)
+  {
+    min.insert(min.end(), other.min.begin(), other.min.end());
+    max.insert(max.end(), other.max.begin(), other.max.end());
+    letter.insert(letter.end(), other.letter.begin(), other.letter.end());
+    offset.insert(offset.end(), other.offset.begin(), other.offset.end());
+    length.insert(length.end(), other.length.begin(), other.length.end());
+  }
+};
+
+Policies parse(const MappedInput &input)
+{
+  const auto text = input.view();
+  return parse_chunked(text, [&](std::string_view chunk) {
+    Policies result;
+    result.reserve(chunk.size() / 24);
+    for (Scanner scanner{ chunk }; !scanner.skip_whitespace().empty();) {
+      const auto policy = parse_policy(scanner);
+      result.push_back(policy, static_cast<std::size_t>(std::get<3>(policy).data() - text.data()));
+    }
+    return result;
+  });
+}
+
+// Passwords are short, so the letter count loads sixteen bytes past the
+// start of each one and masks off the rest; see count_byte.
+long long count_valid_counts(const Policies &policies, std::string_view text)
+{
+  const auto *base = text.data();
+  const auto *readable_end = base + text.size();
+  long long valid = 0;
+  for (std::size_t i = 0; i < policies.size(); ++i) {
+    const auto *password = base + policies.offset[i];
+    const auto n_chars = count_byte(password, password + policies.length[i], readable_end, policies.letter[i]);
+    valid += (n_chars >= policies.min[i]) & (n_chars <= policies.max[i]);
+  }
+  return valid;
+}
+
+long long count_valid_positions(const Policies &policies, std::string_view text)
+{
+  const auto *base = text.data();
+  long long valid = 0;
+  for (std::size_t i = 0; i < policies.size(); ++i) {
+    // One before the password, so positions index it directly; position 0
+    // is the blank before it and is read instead of out-of-range positions.
+    const auto *password = base + policies.offset[i] - 1;
+    const auto c = policies.letter[i];
+    const std::uint32_t length = policies.length[i];
+    const auto matches = [&](std::uint32_t position) {
+      const auto in_range = position - 1 < length;
+      return in_range & (password[in_range ? position : 0] == c);
+    };
+    valid += matches(policies.min[i]) ^ matches(policies.max[i]);
   }
+  return valid;
+}
 
-  return result;
+bool is_valid_count(const policy_t &policy)
+{
+  const auto &[min, max, c, s] = policy;
+  const auto n_chars = ranges::count(s, c);
+  return n_chars >= min && n_chars <= max;
+}
+
+bool is_valid_position(const policy_t &policy)
+{
+  const auto &[min, max, c, s] = policy;
+  // Positions outside of the password never match.
+  const auto matches = [&](int position) { return position >= 1 && static_cast<std::size_t>(position) <= s.size() && s[position - 1] == c; };
+  return matches(min) != matches(max);
 }
 
-int main(int argc, char **argv)
+// Both answers are counts over independent lines, so standard input is
+// folded line by line without keeping the passwords around.
+Answers stream(const std::filesystem::path &input)
+{
+  return timed("stream", [&] {
+    long long part1 = 0;
+    long long part2 = 0;
+    RecordStream records{ input };
+    while (const auto line = records.next()) {
+      Scanner scanner{ *line };
+      if (scanner.skip_whitespace().empty()) continue;
+      const auto policy = parse_policy(scanner);
+      part1 += is_valid_count(policy);
+      part2 += is_valid_position(policy);
+    }
+    return Answers{ fmt::format("{}", part1), fmt::format("{}", part2) };
+  });
+}
+
+}// namespace
+
+Answers day2(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
+  if (is_stdin(input)) return stream(input);
 
-  fmt::print(
-    "Part 1: {}\n",
-    ranges::count_if(data, [](const auto &el) {
-      const auto &[min, max, c, s] = el;
-      const auto n_chars = ranges::count(s, c);
-      return n_chars >= min && n_chars <= max;
-    }));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto data = timed("parse", [&] { return parse(buffer); });
 
-  fmt::print(
-    "Part 2: {}\n",
-    ranges::count_if(data, [](const auto &el) {
-      const auto &[min, max, c, s] = el;
-      return (s[min - 1] == c) != (s[max - 1] == c);
-    }));
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", count_valid_counts(data, buffer.view())); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", count_valid_positions(data, buffer.view())); });
+  return answers;
 }
@@ -1,14 +1,19 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 #include "padded_vector_2d.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <array>
+#include <bit>
 #include <vector>
 #include <regex>
 #include <map>
 #include <stack>
 
+namespace {
+
 using Picture = std::array<std::array<bool, 8>, 8>;
 using Edge = std::array<bool, 10>;
 
@@ -38,9 +43,6 @@ struct Block
   std::array<Edge, 4> edges;
 };
 
-bool operator<(const Block &l, const Block &r) { return l.id < r.id; }
-bool operator==(const Block& l, const Block& r) { return l.id == r.id; }
-
 std::regex id_line_regex{ R"(Tile (\d+):)"};
 
 Block parse_block(const std::vector<std::string>& block) {
@@ -221,23 +223,24 @@ Reconstruction reconstruct(std::map<int, Block> blocks) {
   return { .grid_row_min = grid_row_min, .grid_row_max = grid_row_max, .grid_col_min = grid_column_min, .grid_col_max = grid_column_max, .inserted = std::move(inserted) };
 }
 
-PaddedVector2D<std::int8_t> picture(const Reconstruction& rec) {
+PaddedVector2D<bool> picture(const Reconstruction& rec) {
   const std::size_t rows = (rec.grid_row_max - rec.grid_row_min + 1) * 8;
   const std::size_t columns = (rec.grid_col_max - rec.grid_col_min + 1) * 8;
-  std::vector<std::int8_t> raw(rows * columns, std::int8_t{ 0 });
+  PaddedVector2D<bool> result{ rows, columns, false };
   for (int row = rec.grid_row_min; row <= rec.grid_row_max; ++row) {
     for (int col = rec.grid_col_min; col <= rec.grid_col_max; ++col) {
       const auto &pic = rec.inserted.find(std::pair(row, col))->second.picture;
       for (int pic_row = 0; pic_row < pic.size(); ++pic_row) {
         for (int pic_col = 0; pic_col < pic[0].size(); ++pic_col) {
-          std::size_t index = ((row - rec.grid_row_min) * 8 + pic_row) * columns + (col - rec.grid_col_min) * 8 + pic_col;
-          raw[index] = pic[pic_row][pic_col] ? 1 : 0;
+          if (pic[pic_row][pic_col]) {
+            result.set((row - rec.grid_row_min) * 8 + pic_row, (col - rec.grid_col_min) * 8 + pic_col, true);
+          }
         }
       }
     }
   }
 
-  return PaddedVector2D{ columns, std::int8_t{ 0 }, raw };
+  return result;
 }
 
 constexpr std::string_view monster_str =
@@ -307,23 +310,50 @@ constexpr std::array monsters{
   rotate_monster(rotate_monster(rotate_monster(flip_monster(original_monster_positions))))
 };
 
-int find_monsters(const PaddedVector2D<std::int8_t>& pic, const std::array<std::pair<int, int>, n_monster_points>& monster) {
+using word_t = PaddedVector2D<bool>::word_t;
+constexpr int word_bits = PaddedVector2D<bool>::word_bits;
+
+// Rows and columns a monster extends below and right of its anchor.
+constexpr auto monster_reach = std::max(max_y(original_monster_positions), max_x(original_monster_positions));
+static_assert(monster_reach < word_bits);
+
+// The row words of the picture, with a halo of empty words wide enough that
+// every monster point read from a data word stays inside the grid.
+PaddedVector2D<word_t> picture_words(const PaddedVector2D<bool>& pic) {
+  std::vector<word_t> words;
+  words.reserve(pic.rows() * pic.words_per_row());
+  for (std::size_t row = 0; row < pic.rows(); ++row) {
+    const auto row_words = pic.row_words(row);
+    words.insert(words.end(), row_words.begin(), row_words.end());
+  }
+  return PaddedVector2D<word_t>{ pic.words_per_row(), word_t{ 0 }, words, monster_reach };
+}
+
+// Tests 64 placements at once: bit i of the candidates word stands for the
+// monster anchored at column 64 * w + i, which survives only if every point
+// of the monster is set in the equally shifted word of its row. Points lie
+// less than a word to the right, so they span the word and the next one.
+int find_monsters(const PaddedVector2D<word_t>& words, int n_cols, const std::array<std::pair<int, int>, n_monster_points>& monster) {
   int count = 0;
-  for (int r = 0; r < pic.rows(); ++r) {
-    for (int c = 0; c < pic.cols(); ++c) {
-      if (ranges::all_of(
-            monster | ranges::views::transform([r, c](auto p) { return std::pair{ p.first + r, p.second + c }; }),
-            [&](auto p) { return pic.at(p.first, p.second) == 1; })) {
-        ++count;
-      }
+  words.stencil([&](int, int w, const auto neighbourhood) {
+    auto candidates = ~word_t{ 0 };
+    for (const auto &[dr, dc] : monster) {
+      const auto low = neighbourhood(dr, 0) >> dc;
+      candidates &= dc == 0 ? low : low | (neighbourhood(dr, 1) << (word_bits - dc));
+      if (candidates == 0) break;
     }
-  }
+    if (const auto remaining = n_cols - w * word_bits; remaining < word_bits) {
+      candidates &= (word_t{ 1 } << remaining) - 1;
+    }
+    count += std::popcount(candidates);
+  });
   return count;
 }
 
-int find_monsters(const PaddedVector2D<std::int8_t>& pic) {
+int find_monsters(const PaddedVector2D<bool>& pic) {
+  const auto words = picture_words(pic);
   for (const auto& m : monsters) {
-    auto count = find_monsters(pic, m);
+    auto count = find_monsters(words, static_cast<int>(pic.cols()), m);
     if (count > 0) {
       return count;
     }
@@ -331,18 +361,24 @@ int find_monsters(const PaddedVector2D<std::int8_t>& pic) {
   return 0;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day20(const std::filesystem::path &input)
 {
-  auto blocks = parse(load_input(argc, argv));
-  const auto rec = reconstruct(std::move(blocks));
+  Answers answers;
+  auto blocks = timed("parse", [&] { return parse(load_input(input)); });
+  const auto rec = timed("part 1", [&] { return reconstruct(std::move(blocks)); });
   auto prod = 1ll;
   for (const auto& b : corners(rec)) {
     prod *= b.get().id;
   }
-  fmt::print("Part 1: {}\n", prod);
-  const auto pic = picture(rec);
-  const auto all_occupied = ranges::count(pic.raw(), 1);
-  fmt::print(
-    "Part 2: {}\n",
-    all_occupied - find_monsters(pic) * n_monster_points);
+  answers.part1 = fmt::format("{}", prod);
+  answers.part2 = timed("part 2", [&] {
+    const auto pic = picture(rec);
+    const auto all_occupied = static_cast<long long>(pic.count());
+    return fmt::format(
+      "{}",
+      all_occupied - find_monsters(pic) * n_monster_points);
+  });
+  return answers;
 }
@@ -1,4 +1,6 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -6,6 +8,8 @@
 #include <unordered_map>
 #include <algorithm>
 
+namespace {
+
 struct Food
 {
   std::vector<std::string> ingredients;// Sorted for set_difference
@@ -102,31 +106,39 @@ std::vector<std::string> dangerous_list(std::unordered_map<std::string, std::vec
          | ranges::to<std::vector>();
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day21(const std::filesystem::path &input)
 {
-  const auto foods = parse(load_input(argc, argv));
-  auto alergen_candidates = candidates(foods);
-  fmt::print(
-    "Part 1: {}\n",
-    ranges::accumulate(
-      foods
-        | ranges::views::transform([&](const auto &f) {
-            return ranges::count_if(
-              f.ingredients,
-              [&](const auto &i) {
-                return ranges::none_of(alergen_candidates, [&](const auto &p) {
-                  return ranges::binary_search(p.second, i);
+  Answers answers;
+  const auto foods = timed("parse", [&] { return parse(load_input(input)); });
+  auto alergen_candidates = timed("candidates", [&] { return candidates(foods); });
+  answers.part1 = timed("part 1", [&] {
+    return fmt::format(
+      "{}",
+      ranges::accumulate(
+        foods
+          | ranges::views::transform([&](const auto &f) {
+              return ranges::count_if(
+                f.ingredients,
+                [&](const auto &i) {
+                  return ranges::none_of(alergen_candidates, [&](const auto &p) {
+                    return ranges::binary_search(p.second, i);
+                  });
                 });
-              });
-          }),
-      0ll));
-  auto alergens = dangerous_list(std::move(alergen_candidates));
-  fmt::print(
-    "Part 2: {}\n",
-    ranges::accumulate(
-      alergens | ranges::views::drop(1),
-      alergens[0],
-      [](auto &&acc, const auto &al) {
-        return acc + ',' + al;
-      }));
+            }),
+        0ll));
+  });
+  answers.part2 = timed("part 2", [&] {
+    auto alergens = dangerous_list(std::move(alergen_candidates));
+    return fmt::format(
+      "{}",
+      ranges::accumulate(
+        alergens | ranges::views::drop(1),
+        alergens[0],
+        [](auto &&acc, const auto &al) {
+          return acc + ',' + al;
+        }));
+  });
+  return answers;
 }
@@ -1,4 +1,7 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -6,22 +9,21 @@
 #include <set>
 #include <utility>
 
-std::pair<std::deque<int>, std::deque<int>> parse(std::istream&& is) {
-  std::deque<int> first;
-  is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  for (std::string line; std::getline(is, line);) {
-    if (line.empty()) {
-      break;
-    } else {
-      first.push_back(std::stoi(line));
-    }
-  }
+namespace {
 
-  std::deque<int> second;
-  is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  for (std::string line; std::getline(is, line);) {
-    second.push_back(std::stoi(line));
+std::deque<int> parse_deck(Scanner &scanner) {
+  std::deque<int> deck;
+  scanner.line();
+  for (auto line = scanner.line(); !line.empty(); line = scanner.line()) {
+    deck.push_back(to_number<int>(line));
   }
+  return deck;
+}
+
+std::pair<std::deque<int>, std::deque<int>> parse(const MappedInput &input) {
+  Scanner scanner{ input.view() };
+  auto first = parse_deck(scanner);
+  auto second = parse_deck(scanner);
   return std::pair{ std::move(first), std::move(second) };
 }
 
@@ -90,13 +92,22 @@ std::pair<Player, std::deque<int>> play_out_recursive_combat(std::deque<int> l,
   return l.empty() ? std::pair{ Player::Two, std::move(r) } : std::pair{ Player::One, std::move(l) };
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day22(const std::filesystem::path &input)
 {
-  const auto [fst, snd] = parse(load_input(argc, argv));
-  fmt::print(
-    "Part 1: {}\n",
-    score(play_out_combat(fst, snd)));
-  fmt::print(
-    "Part 2: {}\n",
-    score(play_out_recursive_combat(fst, snd).second));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto [fst, snd] = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] {
+    return fmt::format(
+      "{}",
+      score(play_out_combat(fst, snd)));
+  });
+  answers.part2 = timed("part 2", [&] {
+    return fmt::format(
+      "{}",
+      score(play_out_recursive_combat(fst, snd).second));
+  });
+  return answers;
 }
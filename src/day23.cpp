@@ -1,9 +1,14 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "options.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <vector>
 
+namespace {
+
 std::vector<int> parse(std::istream&& is) {
   std::vector<int> result;
   char c;
@@ -53,10 +58,6 @@ std::vector<int> as_vector(const next_list &cups, int head) {
   return result;
 }
 
-std::vector<int> as_vector(const next_list& cups) {
-  return as_vector(cups, cups.head);
-}
-
 next_list play_cups(next_list cups, int count) {
   for (int i = 0; i < count; ++i) {
     const auto splice_first = next(cups);
@@ -79,24 +80,33 @@ next_list play_cups(next_list cups, int count) {
   return cups;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day23(const std::filesystem::path &input)
 {
-  const auto cups = parse(load_input(argc, argv));
-  auto play1 = play_cups(to_next_list(cups), 100);
-  auto part1 = as_vector(play1, 0);
-  fmt::print(
-    "Part 1: {}\n",
-    part1
-      | ranges::views::drop(1)
-      | ranges::views::transform([](auto el) { return el + '0'; })
-      | ranges::to<std::string>);
-  auto cups2 = cups;
-  cups2.reserve(1'000'000);
-  while (cups2.size() < 1'000'000) {
-    cups2.push_back(cups2.size() + 1);
-  }
-  auto play2 = play_cups(to_next_list(cups2), 10'000'000);
-  long long v1 = next(play2, 0) + 1;
-  long long v2 = next(play2, 0, 2) + 1;
-  fmt::print("Part 2: {}\n", v1 * v2);
+  Answers answers;
+  const auto cups = timed("parse", [&] { return parse(load_input(input)); });
+  answers.part1 = timed("part 1", [&] {
+    auto play1 = play_cups(to_next_list(cups), 100);
+    auto part1 = as_vector(play1, 0);
+    return fmt::format(
+      "{}",
+      part1
+        | ranges::views::drop(1)
+        | ranges::views::transform([](auto el) { return el + '0'; })
+        | ranges::to<std::string>);
+  });
+  answers.part2 = timed("part 2", [&] {
+    const auto n_cups = option("DAY23_CUPS", std::size_t{ 1'000'000 });
+    auto cups2 = cups;
+    cups2.reserve(n_cups);
+    while (cups2.size() < n_cups) {
+      cups2.push_back(cups2.size() + 1);
+    }
+    auto play2 = play_cups(to_next_list(cups2), option("DAY23_MOVES", 10'000'000));
+    long long v1 = next(play2, 0) + 1;
+    long long v2 = next(play2, 0, 2) + 1;
+    return fmt::format("{}", v1 * v2);
+  });
+  return answers;
 }
@@ -1,4 +1,8 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
@@ -6,6 +10,8 @@
 #include <unordered_set>
 #include <unordered_map>
 
+namespace {
+
 template<typename T>
 inline constexpr void hash_combine(std::size_t &s, const T &v)
 {
@@ -13,6 +19,7 @@ inline constexpr void hash_combine(std::size_t &s, const T &v)
   s ^= std::hash<T>()(v) + 0x9e3779b9 + (s << 6) + (s >> 2);
 };
 
+}// namespace
 
 namespace std {
 
@@ -31,6 +38,8 @@ struct hash<std::array<T, N>>
 
 } // namespace std
 
+namespace {
+
 using Coord = std::array<int, 3>;
 constexpr Coord east{ +1, -1, 0 };
 constexpr Coord west{ -1, +1, 0 };
@@ -72,10 +81,17 @@ Coord parse_coordinate(std::string_view s) {
   return result;
 }
 
-std::unordered_set<Coord> parse(std::istream&& is) {
+std::vector<Coord> parse_chunk(std::string_view chunk) {
+  std::vector<Coord> result;
+  for (Scanner scanner{ chunk }; !scanner.empty();) {
+    result.push_back(parse_coordinate(scanner.line()));
+  }
+  return result;
+}
+
+std::unordered_set<Coord> parse(const MappedInput &input) {
   std::unordered_set<Coord> result;
-  for (std::string line; std::getline(is, line);) {
-    const auto coord = parse_coordinate(line);
+  for (const auto coord : parse_chunked(input.view(), parse_chunk)) {
     const auto [it, inserted] = result.insert(coord);
     if (!inserted) {
       result.erase(it);
@@ -93,7 +109,7 @@ std::unordered_set<Coord> propagate(std::unordered_set<Coord> blacks, int count)
       }
     }
     std::unordered_set<Coord> new_blacks;
-    for (const auto [p, v] : black_neighbours) {
+    for (const auto &[p, v] : black_neighbours) {
       const auto is_black = blacks.contains(p);
       if ((is_black && (v == 1 || v == 2)) || (!is_black && v == 2)) {
         new_blacks.insert(p);
@@ -104,9 +120,14 @@ std::unordered_set<Coord> propagate(std::unordered_set<Coord> blacks, int count)
   return blacks;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day24(const std::filesystem::path &input)
 {
-  auto data = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", data.size());
-  fmt::print("Part 2: {}\n", propagate(std::move(data), 100).size());
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  auto data = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", data.size()); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", propagate(std::move(data), 100).size()); });
+  return answers;
 }
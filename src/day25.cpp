@@ -1,8 +1,12 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 
+namespace {
+
 std::pair<long long, long long> parse(std::istream&& is) {
   long long k1;
   is >> k1;
@@ -26,9 +30,15 @@ int find_rounds(long long n) {
   return i;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day25(const std::filesystem::path &input)
 {
-  const auto [k1, k2] = parse(load_input(argc, argv));
-  const long long k1_rounds = find_rounds(k1);
-  fmt::print("Part 1: {}\n", round(1, k2, k1_rounds));
+  Answers answers;
+  const auto [k1, k2] = timed("parse", [&] { return parse(load_input(input)); });
+  answers.part1 = timed("part 1", [&] {
+    const long long k1_rounds = find_rounds(k1);
+    return fmt::format("{}", round(1, k2, k1_rounds));
+  });
+  return answers;
 }
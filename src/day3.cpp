@@ -1,48 +1,100 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "padded_vector_2d.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
 #include <functional>
-#include <string>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
-std::vector<std::string> parse(std::istream &&is)
+namespace {
+
+using Forest = PaddedVector2D<bool>;
+
+// Trees are set bits, one packed row per input line.
+Forest parse(const MappedInput &input)
 {
-  std::vector<std::string> result;
-  for (std::string line; std::getline(is, line);) {
-    result.push_back(line);
+  auto lines = input.lines() | ranges::views::take_while([](std::string_view line) { return !line.empty(); }) | ranges::to<std::vector>;
+  if (lines.empty()) throw std::runtime_error{ "Empty forest" };
+
+  Forest forest{ lines.size(), lines.front().size(), false };
+  for (std::size_t row = 0; row < lines.size(); ++row) {
+    if (lines[row].size() != forest.cols()) throw std::runtime_error{ fmt::format("Row {} has a different width", row) };
+    auto words = forest.row_words(row);
+    for (std::size_t column = 0; column < lines[row].size(); ++column) {
+      words[column / Forest::word_bits] |= Forest::word_t{ lines[row][column] == '#' } << (column % Forest::word_bits);
+    }
   }
-  return result;
+  return forest;
 }
 
+struct Slope
+{
+  int down;
+  int right;
+};
+
 static constexpr std::array slopes{
-  std::pair{ 1, 1 },
-  std::pair{ 1, 3 },
-  std::pair{ 1, 5 },
-  std::pair{ 1, 7 },
-  std::pair{ 2, 1 },
+  Slope{ 1, 1 },
+  Slope{ 1, 3 },
+  Slope{ 1, 5 },
+  Slope{ 1, 7 },
+  Slope{ 2, 1 },
 };
 
-int count_hits(const std::vector<std::string> data, std::pair<int, int> slope)
+// Trees hit on each slope, all slopes evaluated in one pass over the rows:
+// every row is loaded once and tested by the slopes that land on it. Each
+// slope keeps its own wrapped column, so no division happens per row.
+std::vector<long long> count_hits(const Forest &forest, std::span<const Slope> slopes)
 {
-  int count = 0;
-  const auto n_columns = data[0].size();
-  for (int row = 0; row < data.size(); row += slope.first) {
-    if (data[row][((row / slope.first) * slope.second) % n_columns] == '#') ++count;
+  struct Walker
+  {
+    std::size_t down;
+    std::size_t right;
+    std::size_t next_row;
+    std::size_t column;
+  };
+
+  const auto n_columns = forest.cols();
+  std::vector<Walker> walkers;
+  walkers.reserve(slopes.size());
+  for (const auto [down, right] : slopes) {
+    if (down < 1 || right < 0) throw std::invalid_argument{ fmt::format("Invalid slope ({}, {})", down, right) };
+    walkers.push_back(Walker{ static_cast<std::size_t>(down), static_cast<std::size_t>(right) % n_columns, 0, 0 });
   }
-  return count;
+
+  std::vector<long long> hits(slopes.size());
+  for (std::size_t row = 0; row < forest.rows(); ++row) {
+    const auto words = forest.row_words(row);
+    for (std::size_t i = 0; i < walkers.size(); ++i) {
+      auto &walker = walkers[i];
+      if (walker.next_row != row) continue;
+      hits[i] += (words[walker.column / Forest::word_bits] >> (walker.column % Forest::word_bits)) & 1u;
+      walker.next_row += walker.down;
+      walker.column += walker.right;
+      if (walker.column >= n_columns) walker.column -= n_columns;
+    }
+  }
+  return hits;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day3(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto forest = timed("parse", [&] { return parse(buffer); });
 
-  fmt::print("Part 1: {}\n", count_hits(data, std::pair{ 1, 3 }));
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", count_hits(forest, std::array{ Slope{ 1, 3 } }).front()); });
 
-  const auto part2 = [&] {
-    return ranges::accumulate(
-      slopes | ranges::views::transform([&](auto slope) { return count_hits(data, slope); }),
-      1,
-      std::multiplies{});
-  }();
-  fmt::print("Part 2: {}\n", part2);
+  const auto part2 = timed("part 2", [&] {
+    return ranges::accumulate(count_hits(forest, slopes), 1ll, std::multiplies{});
+  });
+  answers.part2 = fmt::format("{}", part2);
+  return answers;
 }
@@ -1,10 +1,18 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
-#include <string>
+#include <array>
 #include <charconv>
 #include <cctype>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+namespace {
 
 template<int min, int max>
 bool is_number_between(std::string_view data)
@@ -64,44 +72,63 @@ static constexpr std::array fields{
   field_t{ "cid", constant<true>, constant<true> },
 };
 
-std::string_view tag(std::string_view field) { return field.substr(0, 3); }
-std::string_view value(std::string_view field) { return field.substr(4); }
+// Perfect hash of the three-letter tags: the tag bytes, read as a number,
+// times a multiplier picked at compile time so that the top bits of the
+// product are distinct for every field. Unknown tags can still land on a
+// used slot, so a hit is confirmed by comparing the tag.
+constexpr std::uint32_t pack_tag(std::string_view tag)
+{
+  return static_cast<std::uint32_t>(static_cast<unsigned char>(tag[0]))
+         | static_cast<std::uint32_t>(static_cast<unsigned char>(tag[1])) << 8
+         | static_cast<std::uint32_t>(static_cast<unsigned char>(tag[2])) << 16;
+}
 
-using passport_t = std::array<std::string, fields.size()>;
+constexpr unsigned tag_hash_bits = 4;
+static_assert(fields.size() <= (1u << tag_hash_bits));
 
-std::vector<passport_t> parse(std::istream &&is)
+constexpr unsigned tag_hash(std::uint32_t packed, std::uint32_t multiplier)
 {
-  std::vector<passport_t> result;
-
-  std::string current_field;
-  passport_t current_passport;
-  bool has_only_valid_tags = true;
-  while (!is.eof()) {
-    is >> current_field;
-    const auto tag_it = ranges::find_if(fields, [t = tag(current_field)](const auto &e) { return std::get<0>(e) == t; });
-    if (tag_it == fields.end()) {
-      has_only_valid_tags= false;
-    } else if (const auto ind = std::distance(fields.cbegin(), tag_it); current_passport[ind].empty()) {
-      current_passport[ind] = value(current_field);
-    } else {
-      has_only_valid_tags = false;
-    }
+  return (packed * multiplier) >> (32 - tag_hash_bits);
+}
 
-    is.ignore();
-    if (is.peek() == '\n') {
-      is.ignore();
-      if (has_only_valid_tags) {
-        result.push_back(std::move(current_passport));
-      }
-      current_passport.fill("");
-      has_only_valid_tags = true;
+constexpr std::uint32_t find_tag_multiplier()
+{
+  // Small multipliers leave the top bits empty, so the search starts from
+  // the 32-bit golden ratio.
+  for (std::uint32_t multiplier = 0x9e3779b1u;; multiplier += 2) {
+    std::uint32_t used = 0;
+    bool collision = false;
+    for (const auto &field : fields) {
+      const auto bit = std::uint32_t{ 1 } << tag_hash(pack_tag(std::get<0>(field)), multiplier);
+      collision = collision || (used & bit) != 0;
+      used |= bit;
     }
+    if (!collision) return multiplier;
+  }
+}
+
+constexpr auto tag_multiplier = find_tag_multiplier();
+
+constexpr auto tag_slots = [] {
+  std::array<std::int8_t, 1u << tag_hash_bits> slots{};
+  slots.fill(-1);
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    slots[tag_hash(pack_tag(std::get<0>(fields[i])), tag_multiplier)] = static_cast<std::int8_t>(i);
   }
-  result.push_back(std::move(current_passport));
+  return slots;
+}();
 
-  return result;
+// Index of the field with the tag, or -1 for unknown tags.
+int field_index(std::string_view tag)
+{
+  if (tag.size() != 3) return -1;
+  const auto index = tag_slots[tag_hash(pack_tag(tag), tag_multiplier)];
+  return index >= 0 && std::get<0>(fields[index]) == tag ? index : -1;
 }
 
+// Values of one passport, viewing into the input buffer.
+using passport_t = std::array<std::string_view, fields.size()>;
+
 template <int validator_index>
 bool is_valid(const passport_t &data)
 {
@@ -110,9 +137,45 @@ bool is_valid(const passport_t &data)
     [](const auto &el) { return std::get<validator_index>(el.first)(el.second); });
 }
 
-int main(int argc, char **argv)
+struct Tally
+{
+  long long complete{ 0 };
+  long long valid{ 0 };
+};
+
+// Passports are validated as soon as their record ends and only counted,
+// so no record outlives its own parse. Records with unknown or repeated
+// tags are dropped.
+Tally parse(const MappedInput &input)
+{
+  Tally tally;
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty();) {
+    passport_t passport;
+    bool has_only_valid_tags = true;
+    for (Scanner record{ scanner.until("\n\n") }; !record.skip_whitespace().empty();) {
+      const auto field = record.until_either(' ', '\n');
+      const auto index = field.size() > 3 && field[3] == ':' ? field_index(field.substr(0, 3)) : -1;
+      if (index < 0 || !passport[index].empty()) {
+        has_only_valid_tags = false;
+      } else {
+        passport[index] = field.substr(4);
+      }
+    }
+    if (!has_only_valid_tags) continue;
+    tally.complete += is_valid<1>(passport);
+    tally.valid += is_valid<2>(passport);
+  }
+  return tally;
+}
+
+}// namespace
+
+Answers day4(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", ranges::count_if(data, is_valid<1>));
-  fmt::print("Part 2: {}\n", ranges::count_if(data, is_valid<2>));
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto tally = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", tally.complete); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", tally.valid); });
+  return answers;
 }
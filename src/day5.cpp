@@ -1,11 +1,27 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "record_stream.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
-#include <string>
+#include <algorithm>
+#include <array>
 #include <cinttypes>
+#include <stdexcept>
+#include <string_view>
+#include <limits>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AOC2020_DAY5_SSE2
+#endif
+
+namespace {
+
 constexpr std::uint64_t seat_id(std::string_view pass) {
   std::uint64_t id{ 0 };
   for (; !pass.empty(); pass = pass.substr(1)) {
@@ -15,27 +31,127 @@ constexpr std::uint64_t seat_id(std::string_view pass) {
   return id;
 }
 
-std::vector<std::uint64_t> parse(std::istream &&is)
+constexpr std::size_t pass_size = 10;
+
+#ifdef AOC2020_DAY5_SSE2
+// movemask puts the first character in the lowest bit, while it is the
+// highest bit of the id.
+constexpr auto reversed_ids = [] {
+  std::array<std::uint16_t, 1u << pass_size> table{};
+  for (std::uint32_t mask = 0; mask < table.size(); ++mask) {
+    for (std::size_t bit = 0; bit < pass_size; ++bit) {
+      table[mask] |= static_cast<std::uint16_t>(((mask >> bit) & 1u) << (pass_size - 1 - bit));
+    }
+  }
+  return table;
+}();
+
+// Decodes the pass at the start of sixteen readable bytes. Bit 2 is clear in
+// 'B' and 'R' and set in 'F' and 'L'; shifting left by five moves it into the
+// sign bit of every byte, where movemask collects it.
+std::uint64_t seat_id_sse2(const char *pass)
+{
+  const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pass));
+  const auto low_bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_slli_epi16(chunk, 5)));
+  return reversed_ids[~low_bits & ((1u << pass_size) - 1)];
+}
+#endif
+
+// Everything the answers need: the missing seat is the xor of all ids from
+// min to max with the xor of the ids seen.
+struct SeatSummary
+{
+  std::uint64_t min{ std::numeric_limits<std::uint64_t>::max() };
+  std::uint64_t max{ 0 };
+  std::uint64_t xor_of_ids{ 0 };
+  std::size_t count{ 0 };
+
+  void add(std::uint64_t id)
+  {
+    min = std::min(min, id);
+    max = std::max(max, id);
+    xor_of_ids ^= id;
+    ++count;
+  }
+
+  void merge(const SeatSummary &other)
+  {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    xor_of_ids ^= other.xor_of_ids;
+    count += other.count;
+  }
+
+  // Xor of 0..n.
+  static constexpr std::uint64_t xor_up_to(std::uint64_t n)
+  {
+    switch (n % 4) {
+    case 0: return n;
+    case 1: return 1;
+    case 2: return n + 1;
+    default: return 0;
+    }
+  }
+
+  std::uint64_t missing() const
+  {
+    if (count == 0) throw std::runtime_error{ "No boarding passes" };
+    const auto all = xor_up_to(max) ^ (min == 0 ? 0 : xor_up_to(min - 1));
+    return all ^ xor_of_ids;
+  }
+};
+
+// Decodes a batch of passes. Well-formed lines with sixteen readable bytes
+// go through the SSE2 decoder without searching for the line end; anything
+// else is decoded character by character.
+SeatSummary summarize(std::string_view text)
 {
-  std::vector<std::uint64_t> result;
-  std::string data;
-  while (!is.eof()) {
-    is >> data;
-    if (!data.empty()) {
-      result.push_back(seat_id(data));
+  SeatSummary summary;
+  for (Scanner scanner{ text }; !scanner.skip_whitespace().empty();) {
+#ifdef AOC2020_DAY5_SSE2
+    if (const auto rest = scanner.rest(); rest.size() >= 16 && rest[pass_size] == '\n') {
+      summary.add(seat_id_sse2(rest.data()));
+      scanner.skip(pass_size + 1);
+      continue;
     }
-    data.clear();
+#endif
+    summary.add(seat_id(scanner.line()));
   }
-  return result;
+  return summary;
+}
+
+SeatSummary parse(const MappedInput &input)
+{
+  const auto partial = parse_chunked(input.view(), [](std::string_view chunk) { return std::vector{ summarize(chunk) }; });
+  SeatSummary summary;
+  for (const auto &p : partial) summary.merge(p);
+  return summary;
 }
 
-int main(int argc, char **argv)
+// Standard input is folded pass by pass into the same summary.
+Answers stream(const std::filesystem::path &input)
+{
+  return timed("stream", [&] {
+    SeatSummary summary;
+    RecordStream records{ input };
+    while (const auto line = records.next()) {
+      if (line->empty()) continue;
+      summary.add(seat_id(*line));
+    }
+    return Answers{ fmt::format("{}", summary.max), fmt::format("{}", summary.missing()) };
+  });
+}
+
+}// namespace
+
+Answers day5(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
-  const auto [min_it, max_it] = ranges::minmax_element(data);
-  fmt::print("Part 1: {}\n", *max_it);
+  if (is_stdin(input)) return stream(input);
 
-  const auto expected_full_sum = ((*min_it + *max_it) * (*max_it - *min_it + 1)) / 2;
-  const auto sum = ranges::accumulate(data, 0ull);
-  fmt::print("Part 2: {}\n", expected_full_sum - sum);
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto summary = timed("parse", [&] { return parse(buffer); });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", summary.max); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", summary.missing()); });
+  return answers;
 }
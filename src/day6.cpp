@@ -1,50 +1,101 @@
 #include "input_file_loader.h"
+#include "chunked_parse.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "record_stream.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
+#include <bit>
+#include <cstdint>
 #include <vector>
-#include <array>
 
-using group_t = std::pair<int, std::array<int, 26>>;
+namespace {
 
-std::vector<group_t> parse(std::istream &&is)
+// Answers are bit masks, bit i for question 'a' + i. A group keeps the
+// union and the intersection of its people's masks.
+struct group_t
 {
-  std::vector<group_t> results;
+  std::uint32_t any{ 0 };
+  std::uint32_t all{ 0 };
+};
 
-  int count{ 0 };
-  std::array<int, 26> group{ 0 };
-  char current;
-  char previous{ 0 };
-  while (!is.eof()) {
-    current = is.get();
-    if (!std::islower(current) && !std::islower(previous)) {
-      results.emplace_back(count, std::move(group));
-      count = 0;
-      group.fill(0);
-    } else if (std::islower(current)) {
-      ++group[current - 'a'];
-    } else {
-      ++count;
-    }
-    std::swap(current, previous);
+std::uint32_t parse_person(std::string_view line)
+{
+  std::uint32_t mask = 0;
+  for (const auto c : line) {
+    const auto question = static_cast<unsigned>(c - 'a');
+    mask |= question < 26 ? std::uint32_t{ 1 } << question : 0;
+  }
+  return mask;
+}
+
+group_t parse_group(std::string_view text)
+{
+  // An empty group answered nothing, not everything.
+  group_t group{ 0, ~std::uint32_t{ 0 } };
+  bool has_people = false;
+  for (Scanner scanner{ text }; !scanner.skip_whitespace().empty();) {
+    const auto mask = parse_person(scanner.line());
+    group.any |= mask;
+    group.all &= mask;
+    has_people = true;
+  }
+  return has_people ? group : group_t{};
+}
+
+// Groups are separated by blank lines, so chunks are cut after "\n\n".
+std::vector<group_t> parse_chunk(std::string_view chunk)
+{
+  std::vector<group_t> results;
+  for (Scanner scanner{ chunk }; !scanner.skip_whitespace().empty();) {
+    results.push_back(parse_group(scanner.until("\n\n")));
   }
   return results;
 }
 
+std::vector<group_t> parse(const MappedInput &input)
+{
+  return parse_chunked(input.view(), parse_chunk, "\n\n");
+}
+
 std::size_t count_distinct_yes(const group_t &g)
 {
-  return ranges::count_if(g.second, [](auto e) { return e > 0; });
+  return static_cast<std::size_t>(std::popcount(g.any));
 }
 
 std::size_t count_group_yes(const group_t &g)
 {
-  return ranges::count_if(g.second, [n = g.first](auto e) { return e == n; });
+  return static_cast<std::size_t>(std::popcount(g.all));
+}
+
+Answers stream(const std::filesystem::path &input)
+{
+  return timed("stream", [&] {
+    long long part1 = 0;
+    long long part2 = 0;
+    RecordStream records{ input, "\n\n" };
+    while (const auto text = records.next()) {
+      const auto group = parse_group(*text);
+      part1 += static_cast<long long>(count_distinct_yes(group));
+      part2 += static_cast<long long>(count_group_yes(group));
+    }
+    return Answers{ fmt::format("{}", part1), fmt::format("{}", part2) };
+  });
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day6(const std::filesystem::path &input)
 {
-  const auto data = parse(load_input(argc, argv));
+  if (is_stdin(input)) return stream(input);
+
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto data = timed("parse", [&] { return parse(buffer); });
 
-  fmt::print("Part 1: {}\n", ranges::accumulate(data | ranges::views::transform(count_distinct_yes), 0ll));
-  fmt::print("Part 2: {}\n", ranges::accumulate(data | ranges::views::transform(count_group_yes), 0ll));
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", ranges::accumulate(data | ranges::views::transform(count_distinct_yes), 0ll)); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", ranges::accumulate(data | ranges::views::transform(count_group_yes), 0ll)); });
+  return answers;
 }
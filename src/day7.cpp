@@ -1,18 +1,28 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <utility>
 #include <string>
 #include <regex>
 #include <exception>
-#include <stack>
+
+namespace {
 
 // TODO: Error handling in parsing should not throw
-// TODO: count_all_children with general purpose DFS
 
 std::pair<std::string, std::vector<std::pair<int, std::string>>> parse_line(std::string line)
 {
@@ -59,61 +69,176 @@ std::pair<std::unordered_map<std::string, std::size_t>, lookup_graph_t> parse(st
   return std::pair{ std::move(names), std::move(graph) };
 }
 
-std::vector<std::vector<std::size_t>> invert(const lookup_graph_t& g)
+std::uint64_t checked_add(std::uint64_t a, std::uint64_t b)
 {
-  std::vector<std::vector<std::size_t>> graph(g.size());
-  for (std::size_t i = 0; i < g.size(); ++i) {
-    for (const auto& [child, count] : g[i]) {
-      graph[child].push_back(i);
-    }
-  }
-  return graph;
+  if (a > std::numeric_limits<std::uint64_t>::max() - b) throw std::overflow_error{ "Bag count does not fit in 64 bits" };
+  return a + b;
+}
+
+std::uint64_t checked_multiply(std::uint64_t a, std::uint64_t b)
+{
+  if (b != 0 && a > std::numeric_limits<std::uint64_t>::max() / b) throw std::overflow_error{ "Bag count does not fit in 64 bits" };
+  return a * b;
 }
 
-std::size_t count_parents(const std::vector<std::vector<std::size_t>>& graph, std::size_t node)
+struct string_hash
 {
-  std::unordered_set<std::size_t> visited;
-  std::stack<std::size_t> stack;
-  stack.push(node);
-  while (!stack.empty()) {
-    const auto curr = stack.top();
-    stack.pop();
-    if (!visited.contains(curr)) {
-      visited.insert(curr);
-      for (auto part : graph[curr]) {
-        stack.push(std::move(part));
+  using is_transparent = void;
+  std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+// Containment rules as a compressed sparse row graph: the children of bag i
+// are m_children[m_offsets[i]] up to m_children[m_offsets[i + 1]], with the
+// matching quantities in m_quantities. The number of bags inside every bag
+// is computed once, children before parents, and the set of bags that can
+// hold each bag once, parents before children, so queries are lookups.
+class BagRules
+{
+public:
+  BagRules(const std::unordered_map<std::string, std::size_t> &names, const lookup_graph_t &graph)
+    : m_offsets(graph.size() + 1)
+  {
+    for (const auto &[name, index] : names) {
+      m_names.emplace(name, index);
+    }
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+      m_offsets[i + 1] = m_offsets[i] + graph[i].size();
+    }
+    m_children.reserve(m_offsets.back());
+    m_quantities.reserve(m_offsets.back());
+    for (const auto &children : graph) {
+      for (const auto &[child, quantity] : children) {
+        if (quantity < 0) throw std::runtime_error{ "Negative bag quantity" };
+        m_children.push_back(static_cast<std::uint32_t>(child));
+        m_quantities.push_back(static_cast<std::uint32_t>(quantity));
       }
     }
+    m_topological_order = topological_order();
+    m_contained.resize(size());
+    for (auto it = m_topological_order.rbegin(); it != m_topological_order.rend(); ++it) {
+      std::uint64_t total = 0;
+      for (auto edge = m_offsets[*it]; edge < m_offsets[*it + 1]; ++edge) {
+        total = checked_add(total, checked_multiply(m_quantities[edge], checked_add(m_contained[m_children[edge]], 1)));
+      }
+      m_contained[*it] = total;
+    }
+    build_ancestors();
   }
-  return visited.size() - 1;
-}
 
-int count_all_children(const lookup_graph_t &graph, std::size_t node, std::vector<int> memo = {})
-{
-  if (memo.empty()) {
-    memo.resize(graph.size());
-    ranges::fill(memo, -1);
+  std::size_t size() const
+  {
+    return m_offsets.size() - 1;
   }
 
-  if (const auto value = memo[node]; value >= 0) {
-    return value;
-  } else if (const auto& children = graph[node]; children.empty()) {
-    memo[node] = 0;
-    return 0;
-  } else {
-    int count = 0;
-    for (const auto& [child, n] : children) {
-      count += n * (count_all_children(graph, child, memo) + 1);
+  // Number of bags inside the named bag; throws for unknown names.
+  std::uint64_t contained_bags(std::string_view name) const
+  {
+    return m_contained[checked_index(name)];
+  }
+
+  // Number of bags that can eventually hold the named bag.
+  std::size_t containing_bags(std::string_view name) const
+  {
+    return m_n_ancestors[checked_index(name)];
+  }
+
+private:
+  std::span<const std::uint64_t> ancestors(std::size_t bag) const
+  {
+    return std::span<const std::uint64_t>{ m_ancestors.data() + bag * m_words_per_set, m_words_per_set };
+  }
+
+  // Transitive closure of the inverted graph, one bitset of bags per bag.
+  // In topological order every parent's set is final before it is merged
+  // into its children. Word j of every set only depends on word j of other
+  // sets, so threads each sweep the whole order over their own block of
+  // words.
+  void build_ancestors()
+  {
+    m_words_per_set = (size() + 63) / 64;
+    m_ancestors.assign(size() * m_words_per_set, 0);
+
+    constexpr std::size_t min_words_per_thread = 16;
+    const auto hardware = std::max(1u, std::thread::hardware_concurrency());
+    const auto n_threads = std::clamp<std::size_t>(m_words_per_set / min_words_per_thread, 1, hardware);
+    const auto sweep = [&](std::size_t first_word, std::size_t last_word) {
+      for (const auto parent : m_topological_order) {
+        const auto *from = m_ancestors.data() + parent * m_words_per_set;
+        const auto parent_word = parent / 64;
+        const auto parent_bit = std::uint64_t{ 1 } << (parent % 64);
+        for (auto edge = m_offsets[parent]; edge < m_offsets[parent + 1]; ++edge) {
+          auto *to = m_ancestors.data() + m_children[edge] * m_words_per_set;
+          for (auto word = first_word; word < last_word; ++word) {
+            to[word] |= from[word];
+          }
+          if (parent_word >= first_word && parent_word < last_word) to[parent_word] |= parent_bit;
+        }
+      }
+    };
+    {
+      std::vector<std::jthread> workers;
+      const auto block = (m_words_per_set + n_threads - 1) / n_threads;
+      for (std::size_t i = 1; i < n_threads; ++i) {
+        workers.emplace_back(sweep, std::min(i * block, m_words_per_set), std::min((i + 1) * block, m_words_per_set));
+      }
+      sweep(0, std::min(block, m_words_per_set));
+    }
+
+    m_n_ancestors.resize(size());
+    for (std::size_t bag = 0; bag < size(); ++bag) {
+      for (const auto word : ancestors(bag)) {
+        m_n_ancestors[bag] += static_cast<std::size_t>(std::popcount(word));
+      }
     }
-    memo[node] = count;
-    return count;
   }
-}
 
-int main(int argc, char **argv)
+  std::size_t checked_index(std::string_view name) const
+  {
+    if (const auto it = m_names.find(name); it != m_names.end()) return it->second;
+    throw std::runtime_error{ fmt::format("Unknown bag \"{}\"", name) };
+  }
+
+  // Parents before children (Kahn's algorithm, so deep nesting needs no
+  // recursion); throws if a bag ends up containing itself.
+  std::vector<std::uint32_t> topological_order() const
+  {
+    std::vector<std::uint32_t> n_parents(size());
+    for (const auto child : m_children) ++n_parents[child];
+
+    std::vector<std::uint32_t> order;
+    order.reserve(size());
+    for (std::uint32_t i = 0; i < size(); ++i) {
+      if (n_parents[i] == 0) order.push_back(i);
+    }
+    for (std::size_t next = 0; next < order.size(); ++next) {
+      const auto node = order[next];
+      for (auto edge = m_offsets[node]; edge < m_offsets[node + 1]; ++edge) {
+        if (--n_parents[m_children[edge]] == 0) order.push_back(m_children[edge]);
+      }
+    }
+    if (order.size() != size()) throw std::runtime_error{ "The bag rules contain a cycle" };
+    return order;
+  }
+
+  std::unordered_map<std::string, std::size_t, string_hash, std::equal_to<>> m_names;
+  std::vector<std::size_t> m_offsets;
+  std::vector<std::uint32_t> m_children;
+  std::vector<std::uint32_t> m_quantities;
+  std::vector<std::uint32_t> m_topological_order;
+  std::vector<std::uint64_t> m_contained;
+  std::size_t m_words_per_set{ 0 };
+  std::vector<std::uint64_t> m_ancestors;
+  std::vector<std::size_t> m_n_ancestors;
+};
+
+}// namespace
+
+Answers day7(const std::filesystem::path &input)
 {
-  const auto [names, graph] = parse(load_input(argc, argv));
-  const auto shiny_gold_index = names.find("shiny gold")->second;
-  fmt::print("Part 1: {}\n", count_parents(invert(graph), shiny_gold_index));
-  fmt::print("Part 2: {}\n", count_all_children(graph, shiny_gold_index));
+  Answers answers;
+  const auto [names, graph] = timed("parse", [&] { return parse(load_input(input)); });
+  const auto rules = timed("graph", [&] { return BagRules{ names, graph }; });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", rules.containing_bags("shiny gold")); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", rules.contained_bags("shiny gold")); });
+  return answers;
 }
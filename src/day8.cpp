@@ -1,37 +1,33 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "handheld_vm.h"
+#include "instrumentation.h"
 
 #include <fmt/core.h>
 #include <range/v3/all.hpp>
+#include <algorithm>
 #include <charconv>
-#include <optional>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
-// TODO: Handle the parsing errors gracefully (lift out of parse)
-// TODO: implement shortest modification path solution for part 2
-
-struct Instruction
-{
-  enum class Type {
-    Acc,
-    Jmp,
-    Noop,
-  };
+namespace {
 
-  Type type;
-  int argument;
-};
+// TODO: Handle the parsing errors gracefully (lift out of parse)
 
-std::vector<Instruction> parse(std::istream &&is)
+std::vector<HandheldInstruction> parse(std::istream &&is)
 {
-  std::vector<Instruction> result;
+  std::vector<HandheldInstruction> result;
   for (std::string line; std::getline(is, line);) {
-    Instruction::Type type = [&] {
+    HandheldInstruction::Type type = [&] {
       if (line.starts_with("acc")) {
-        return Instruction::Type::Acc;
+        return HandheldInstruction::Type::Acc;
       } else if (line.starts_with("jmp")) {
-        return Instruction::Type::Jmp;
+        return HandheldInstruction::Type::Jmp;
       } else {
-        return Instruction::Type::Noop;
+        return HandheldInstruction::Type::Noop;
       }
     }();
     int arg;
@@ -41,59 +37,93 @@ std::vector<Instruction> parse(std::istream &&is)
   return result;
 }
 
-std::pair<bool, int> run_until_first_loop(const std::vector<Instruction> &program)
+struct Repair
 {
-  std::vector<bool> hit(program.size(), false);
-  int acc{ 0 };
+  std::size_t index;
+  long long accumulator;
+};
+
+// Every way to make a looping program terminate by swapping one jmp/nop, in
+// program order, with the accumulator it ends with. Each instruction has a
+// single successor, so the instructions that reach the end are those found
+// by walking the control flow backwards from the exits. A swap repairs the
+// program when it sends the original path into that set; the original path
+// loops, so it never leads back to the swapped instruction. O(n) overall.
+std::vector<Repair> find_repairs(std::span<const HandheldOp> program)
+{
+  const auto n = static_cast<long long>(program.size());
+  const auto outside = [n](long long pc) { return pc < 0 || pc >= n; };
 
-  for (int cursor = 0; cursor < program.size();) {
-    const auto [t, a] = program[cursor];
-    if (hit[cursor]) {
-      return std::pair{ false, acc };
-    } else {
-      hit[cursor] = true;
+  std::vector<std::size_t> offsets(program.size() + 1);
+  for (long long i = 0; i < n; ++i) {
+    if (const auto next = i + program[i].pc_delta; !outside(next)) ++offsets[next + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::uint32_t> predecessors(offsets.back());
+  {
+    auto fill = offsets;
+    for (long long i = 0; i < n; ++i) {
+      if (const auto next = i + program[i].pc_delta; !outside(next)) predecessors[fill[next]++] = static_cast<std::uint32_t>(i);
     }
+  }
 
-    if (t == Instruction::Type::Jmp) {
-      cursor += a;
-    } else if (t == Instruction::Type::Acc) {
-      acc += a;
-      ++cursor;
-    } else {
-      ++cursor;
+  std::vector<bool> terminates(program.size(), false);
+  std::vector<long long> accumulated_to_end(program.size());
+  std::vector<std::uint32_t> queue;
+  for (long long i = 0; i < n; ++i) {
+    if (outside(i + program[i].pc_delta)) {
+      terminates[i] = true;
+      accumulated_to_end[i] = program[i].acc_delta;
+      queue.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const auto next = queue[head];
+    for (auto edge = offsets[next]; edge < offsets[next + 1]; ++edge) {
+      const auto pc = predecessors[edge];
+      terminates[pc] = true;
+      accumulated_to_end[pc] = program[pc].acc_delta + accumulated_to_end[next];
+      queue.push_back(pc);
     }
   }
 
-  return std::pair{ true, acc };
+  std::vector<Repair> repairs;
+  std::vector<bool> visited(program.size(), false);
+  long long accumulator = 0;
+  long long pc = 0;
+  for (; !outside(pc) && !visited[pc]; pc += program[pc].pc_delta) {
+    visited[pc] = true;
+    // Swapping an acc, or a jmp/nop by one, changes nothing.
+    if (program[pc].swapped_pc_delta != program[pc].pc_delta) {
+      if (const auto swapped = pc + program[pc].swapped_pc_delta; outside(swapped)) {
+        repairs.push_back(Repair{ static_cast<std::size_t>(pc), accumulator });
+      } else if (terminates[swapped]) {
+        repairs.push_back(Repair{ static_cast<std::size_t>(pc), accumulator + accumulated_to_end[swapped] });
+      }
+    }
+    accumulator += program[pc].acc_delta;
+  }
+  // A program that already terminates has nothing to repair.
+  if (outside(pc)) return {};
+
+  std::sort(repairs.begin(), repairs.end(), [](const auto &l, const auto &r) { return l.index < r.index; });
+  return repairs;
 }
 
-std::optional<std::vector<Instruction>> fix_program(const std::vector<Instruction> &program)
+long long repaired_accumulator(std::span<const HandheldOp> program)
 {
-  const auto next_possible_index = [&](auto curr) {
-    return std::distance(
-      program.begin(),
-      std::find_if(
-        program.begin() + curr,
-        program.end(),
-        [](auto el) {
-          return el.type == Instruction::Type::Jmp || el.type == Instruction::Type::Noop;
-        }));
-  };
-  auto program_copy = program;
-  for (auto i = next_possible_index(0); i < program.size(); i = next_possible_index(i + 1)) {
-    program_copy[i].type = program[i].type == Instruction::Type::Noop ? Instruction::Type::Jmp : Instruction::Type::Noop;
-    if (run_until_first_loop(program_copy).first) {
-      return program_copy;
-    } else {
-      program_copy[i] = program[i];
-    }
-  }
-  return std::nullopt;
+  const auto repairs = find_repairs(program);
+  if (repairs.empty()) throw std::runtime_error{ "No single jmp/nop swap makes the program terminate" };
+  return repairs.front().accumulator;
 }
 
-int main(int argc, char **argv)
+}// namespace
+
+Answers day8(const std::filesystem::path &input)
 {
-  const auto program = parse(load_input(argc, argv));
-  fmt::print("Part 1: {}\n", run_until_first_loop(program).second);
-  fmt::print("Part 2: {}\n", run_until_first_loop(*fix_program(program)).second);
+  Answers answers;
+  auto vm = timed("parse", [&] { return HandheldVm{ parse(load_input(input)) }; });
+  answers.part1 = timed("part 1", [&] { return fmt::format("{}", vm.run().accumulator); });
+  answers.part2 = timed("part 2", [&] { return fmt::format("{}", repaired_accumulator(vm.ops())); });
+  return answers;
 }
@@ -1,65 +1,191 @@
 #include "input_file_loader.h"
+#include "days.h"
+#include "instrumentation.h"
+#include "options.h"
+#include "scanner.h"
 
 #include <range/v3/all.hpp>
 #include <fmt/core.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-std::vector<long long> parse(std::istream&& is)
+namespace {
+
+std::vector<long long> parse(const MappedInput &input)
 {
   std::vector<long long> result;
-  long long el;
-  while (is >> el) {
-    result.push_back(el);
+  result.reserve(input.line_count());
+  for (Scanner scanner{ input.view() }; !scanner.skip_whitespace().empty();) {
+    result.push_back(scanner.number<long long>());
   }
   return result;
 }
 
-template <typename Iter, typename T>
-bool contains_sum(Iter begin, Iter end, const T& value) {
-  for (; begin + 1 != end; ++begin) {
-    for (auto it = begin + 1; it != end; ++it) {
-      if (*begin + *it == value && *begin != *it) return true;
-    }
+// Counts of the values in a sliding window of the input.
+class WindowMultiset
+{
+public:
+  explicit WindowMultiset(std::size_t window)
+  {
+    m_counts.reserve(2 * window);
+  }
+
+  void insert(long long value)
+  {
+    ++m_counts[value];
+  }
+
+  void erase(long long value)
+  {
+    if (const auto it = m_counts.find(value); --it->second == 0) m_counts.erase(it);
+  }
+
+  bool contains(long long value) const
+  {
+    return m_counts.contains(value);
+  }
+
+private:
+  std::unordered_map<long long, int> m_counts;
+};
+
+// Whether two different values of the window sum to the target. Sums are
+// formed in 128 bits, so no value can overflow the complement.
+bool contains_sum(std::span<const long long> window, const WindowMultiset &values, long long target)
+{
+  for (const auto value : window) {
+    const auto complement = static_cast<__int128>(target) - value;
+    if (complement == value || complement < std::numeric_limits<long long>::min() || complement > std::numeric_limits<long long>::max()) continue;
+    if (values.contains(static_cast<long long>(complement))) return true;
   }
   return false;
 }
 
-int main(int argc, char** argv)
+// Indices in [first, last) of values that are not the sum of two different
+// values among the `window` before them. The window's values are kept in a
+// hash multiset updated as values enter and leave, so each check is
+// O(window). In first-only mode the scan stops at its first hit, or once
+// it has passed a hit that another chunk published in `earliest`.
+std::vector<std::size_t> scan_invalid(std::span<const long long> data, std::size_t window, std::size_t first, std::size_t last, bool first_only, std::atomic<std::size_t> &earliest)
 {
-  const auto data = parse(load_input(argc, argv));
-
-  const auto part1 = [&] {
-    auto begin = data.cbegin();
-    auto end = data.cbegin() + 25;
-    while (end != data.cend()) {
-      if (!contains_sum(begin, end, *end)) {
-        return *end;
+  std::vector<std::size_t> invalid;
+  WindowMultiset values{ window };
+  for (auto i = first - window; i < first; ++i) values.insert(data[i]);
+  for (auto i = first; i < last; ++i) {
+    if (first_only && (i & 0xfff) == 0 && earliest.load(std::memory_order_relaxed) < i) break;
+    if (!contains_sum(data.subspan(i - window, window), values, data[i])) {
+      invalid.push_back(i);
+      if (first_only) {
+        auto current = earliest.load(std::memory_order_relaxed);
+        while (i < current && !earliest.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+        break;
       }
-      ++begin;
-      ++end;
     }
-    return -1ll;
-  }();
-  fmt::print("Part 1: {}\n", part1);
-
-  const auto part2 = [&, part1] {
-    auto begin = data.cbegin();
-    auto end = data.cbegin() + 1;
-    auto sum = *begin;
-    while (end != data.end()) {
-      if (sum == part1) {
-        auto mm = ranges::minmax_element(begin, end);
-        return *mm.min + *mm.max;
-      } else if (sum < part1) {
-        sum += *end;
-        ++end;
-      } else {
-        sum -= *begin;
-        ++begin;
-      }
+    values.erase(data[i - window]);
+    values.insert(data[i]);
+  }
+  return invalid;
+}
+
+// Invalid indices, in order: only the first one, or all of them. Every
+// position depends only on the `window` values before it, so the positions
+// are split into one range per thread (AOC_DAY9_THREADS, by default the
+// hardware concurrency), each starting from its own copy of the window
+// that overlaps the previous range.
+std::vector<std::size_t> find_invalid(std::span<const long long> data, std::size_t window, bool first_only)
+{
+  if (window < 2) throw std::invalid_argument{ "The preamble needs at least two values" };
+  if (data.size() <= window) return {};
+
+  constexpr std::size_t min_positions_per_thread = 1 << 16;
+  const auto positions = data.size() - window;
+  const auto threads = option("DAY9_THREADS", std::max(1u, std::thread::hardware_concurrency()));
+  const auto n_ranges = std::clamp<std::size_t>(positions / min_positions_per_thread, 1, std::max(1u, threads));
+  const auto range_size = (positions + n_ranges - 1) / n_ranges;
+
+  std::atomic<std::size_t> earliest{ data.size() };
+  std::vector<std::vector<std::size_t>> partial(n_ranges);
+  const auto run = [&](std::size_t range) {
+    const auto first = window + range * range_size;
+    partial[range] = scan_invalid(data, window, first, std::min(first + range_size, data.size()), first_only, earliest);
+  };
+  {
+    std::vector<std::jthread> workers;
+    for (std::size_t range = 1; range < n_ranges; ++range) {
+      workers.emplace_back(run, range);
     }
+    run(0);
+  }
 
-    return -1ll;
-  }();
-  fmt::print("Part 2: {}\n", part2);
-}
\ No newline at end of file
+  std::vector<std::size_t> invalid;
+  for (const auto &p : partial) {
+    invalid.insert(invalid.end(), p.begin(), p.end());
+    if (first_only && !invalid.empty()) break;
+  }
+  return invalid;
+}
+
+std::optional<std::size_t> first_invalid(std::span<const long long> data, std::size_t window)
+{
+  const auto invalid = find_invalid(data, window, true);
+  if (invalid.empty()) return std::nullopt;
+  return invalid.front();
+}
+
+struct int128_hash
+{
+  std::size_t operator()(__int128 value) const
+  {
+    const auto bits = static_cast<unsigned __int128>(value);
+    return std::hash<std::uint64_t>{}(static_cast<std::uint64_t>(bits) ^ static_cast<std::uint64_t>(bits >> 64) * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+// Sum of the smallest and largest value of the first run of at least two
+// consecutive values that adds up to the target. Runs are differences of
+// 128-bit prefix sums, looked up by value, so negative values are fine.
+std::optional<long long> encryption_weakness(std::span<const long long> data, long long target)
+{
+  std::unordered_map<__int128, std::size_t, int128_hash> prefix_index;
+  prefix_index.reserve(data.size());
+  std::vector<__int128> prefix(data.size() + 1);
+  for (std::size_t i = 0; i < data.size(); ++i) prefix[i + 1] = prefix[i] + data[i];
+
+  for (std::size_t end = 2; end <= data.size(); ++end) {
+    prefix_index.try_emplace(prefix[end - 2], end - 2);
+    if (const auto it = prefix_index.find(prefix[end] - target); it != prefix_index.end()) {
+      const auto [min, max] = std::minmax_element(data.begin() + it->second, data.begin() + end);
+      return *min + *max;
+    }
+  }
+  return std::nullopt;
+}
+
+}// namespace
+
+Answers day9(const std::filesystem::path &input)
+{
+  Answers answers;
+  const auto buffer = timed("map", [&] { return map_input(input); });
+  const auto data = timed("parse", [&] { return parse(buffer); });
+  const auto preamble = option("DAY9_PREAMBLE", std::size_t{ 25 });
+
+  const auto part1 = timed("part 1", [&] {
+    const auto index = first_invalid(data, preamble);
+    return index ? data[*index] : -1ll;
+  });
+  answers.part1 = fmt::format("{}", part1);
+
+  const auto part2 = timed("part 2", [&, part1] { return encryption_weakness(data, part1).value_or(-1ll); });
+  answers.part2 = fmt::format("{}", part2);
+  return answers;
+}
@@ -0,0 +1,43 @@
+#ifndef AOC2020_DAYS_
+#define AOC2020_DAYS_
+
+#include "solver.h"
+
+#include <array>
+
+Answers day1(const std::filesystem::path &input);
+Answers day2(const std::filesystem::path &input);
+Answers day3(const std::filesystem::path &input);
+Answers day4(const std::filesystem::path &input);
+Answers day5(const std::filesystem::path &input);
+Answers day6(const std::filesystem::path &input);
+Answers day7(const std::filesystem::path &input);
+Answers day8(const std::filesystem::path &input);
+Answers day9(const std::filesystem::path &input);
+Answers day10(const std::filesystem::path &input);
+Answers day11(const std::filesystem::path &input);
+Answers day12(const std::filesystem::path &input);
+Answers day13(const std::filesystem::path &input);
+Answers day14(const std::filesystem::path &input);
+Answers day15(const std::filesystem::path &input);
+Answers day16(const std::filesystem::path &input);
+Answers day17(const std::filesystem::path &input);
+Answers day18(const std::filesystem::path &input);
+Answers day19(const std::filesystem::path &input);
+Answers day20(const std::filesystem::path &input);
+Answers day21(const std::filesystem::path &input);
+Answers day22(const std::filesystem::path &input);
+Answers day23(const std::filesystem::path &input);
+Answers day24(const std::filesystem::path &input);
+Answers day25(const std::filesystem::path &input);
+
+// Solver of day N at index N - 1.
+inline constexpr std::array<solver_t, 25> solvers{
+  day1, day2, day3, day4, day5,
+  day6, day7, day8, day9, day10,
+  day11, day12, day13, day14, day15,
+  day16, day17, day18, day19, day20,
+  day21, day22, day23, day24, day25
+};
+
+#endif // AOC2020_DAYS_
@@ -0,0 +1,96 @@
+#ifndef AOC2020_HANDHELD_VM_
+#define AOC2020_HANDHELD_VM_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct HandheldInstruction
+{
+  enum class Type {
+    Acc,
+    Jmp,
+    Noop,
+  };
+
+  Type type;
+  int argument;
+};
+
+// An instruction decoded into what it does: executing it adds acc_delta to
+// the accumulator and pc_delta to the program counter, so the interpreter
+// loop has no dispatch at all. swapped_pc_delta is the pc_delta with a jmp
+// and a nop exchanged.
+struct HandheldOp
+{
+  std::int32_t acc_delta;
+  std::int32_t pc_delta;
+  std::int32_t swapped_pc_delta;
+};
+
+// Reusable interpreter for the handheld console. Loops are detected by
+// stamping each executed instruction with the number of the current run,
+// so starting a run neither allocates nor clears anything.
+class HandheldVm
+{
+public:
+  struct Result
+  {
+    // Whether the run left the program instead of repeating an instruction.
+    bool terminated;
+    long long accumulator;
+  };
+
+  explicit HandheldVm(std::span<const HandheldInstruction> program)
+    : m_visited(program.size(), 0)
+  {
+    m_ops.reserve(program.size());
+    for (const auto [type, argument] : program) {
+      switch (type) {
+      case HandheldInstruction::Type::Acc:
+        m_ops.push_back(HandheldOp{ argument, 1, 1 });
+        break;
+      case HandheldInstruction::Type::Jmp:
+        m_ops.push_back(HandheldOp{ 0, argument, 1 });
+        break;
+      case HandheldInstruction::Type::Noop:
+        m_ops.push_back(HandheldOp{ 0, 1, argument });
+        break;
+      }
+    }
+  }
+
+  std::span<const HandheldOp> ops() const
+  {
+    return m_ops;
+  }
+
+  // Runs from the first instruction until the program counter leaves the
+  // program or an instruction is about to run a second time.
+  Result run()
+  {
+    if (++m_run == 0) {
+      std::fill(m_visited.begin(), m_visited.end(), 0);
+      m_run = 1;
+    }
+    const auto n = static_cast<long long>(m_ops.size());
+    long long accumulator = 0;
+    long long pc = 0;
+    while (pc >= 0 && pc < n && m_visited[pc] != m_run) {
+      m_visited[pc] = m_run;
+      const auto op = m_ops[pc];
+      accumulator += op.acc_delta;
+      pc += op.pc_delta;
+    }
+    return Result{ pc < 0 || pc >= n, accumulator };
+  }
+
+private:
+  std::vector<HandheldOp> m_ops;
+  std::vector<std::uint32_t> m_visited;
+  std::uint32_t m_run{ 0 };
+};
+
+#endif // AOC2020_HANDHELD_VM_
@@ -1,9 +1,22 @@
 #ifndef AOC2020_INPUT_FILE_LOADER_
 #define AOC2020_INPUT_FILE_LOADER_
 
+#include "mapped_input.h"
+
+#include <filesystem>
 #include <fstream>
 #include <memory>
 
+// "-" stands for standard input wherever an input path is accepted.
+bool is_stdin(const std::filesystem::path& path);
+
+std::filesystem::path default_input_path(int day);
+std::filesystem::path input_path(int argc, char** argv);
+
+std::ifstream load_input(const std::filesystem::path& path);
 std::ifstream load_input(int argc, char** argv);
 
+MappedInput map_input(const std::filesystem::path& path);
+MappedInput map_input(int argc, char** argv);
+
 #endif //AOC2020_INPUT_FILE_LOADER_
\ No newline at end of file
@@ -0,0 +1,830 @@
+#include "input_generators.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+
+using rng_t = std::mt19937_64;
+
+long long uniform(rng_t &rng, long long min, long long max)
+{
+  return std::uniform_int_distribution<long long>{ min, max }(rng);
+}
+
+bool chance(rng_t &rng, double p)
+{
+  return std::bernoulli_distribution{ p }(rng);
+}
+
+std::size_t scaled(double base, double scale)
+{
+  return std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(base * scale)));
+}
+
+// Side of a square grid whose area grows linearly with the scale.
+std::size_t scaled_side(double base, double scale)
+{
+  return std::max<std::size_t>(2, static_cast<std::size_t>(std::llround(base * std::sqrt(scale))));
+}
+
+template<typename T>
+const T &pick(rng_t &rng, const std::vector<T> &values)
+{
+  return values[uniform(rng, 0, static_cast<long long>(values.size()) - 1)];
+}
+
+std::string random_word(rng_t &rng, int min_length, int max_length)
+{
+  std::string word(uniform(rng, min_length, max_length), 'a');
+  for (auto &c : word) c = static_cast<char>('a' + uniform(rng, 0, 25));
+  return word;
+}
+
+// Lower case letters only, distinct for distinct indices.
+std::string letters(std::size_t index)
+{
+  std::string result;
+  do {
+    result.push_back(static_cast<char>('a' + index % 26));
+    index /= 26;
+  } while (index > 0);
+  return result;
+}
+
+std::string signed_number(long long value)
+{
+  return fmt::format("{}{}", value < 0 ? '-' : '+', std::abs(value));
+}
+
+GeneratedInput generate_day1(double scale, rng_t &rng)
+{
+  const auto n = scaled(200, scale);
+  std::vector<int> values;
+  const auto a = static_cast<int>(uniform(rng, 1, 1009));
+  values.push_back(a);
+  values.push_back(2020 - a);
+  const auto b = static_cast<int>(uniform(rng, 1, 600));
+  const auto c = static_cast<int>(uniform(rng, 601, 1300));
+  values.push_back(b);
+  values.push_back(c);
+  values.push_back(2020 - b - c);
+  while (values.size() < n) {
+    values.push_back(static_cast<int>(uniform(rng, 1, 2019)));
+  }
+  std::shuffle(values.begin(), values.end(), rng);
+
+  GeneratedInput result;
+  for (const auto v : values) result.text += fmt::format("{}\n", v);
+  return result;
+}
+
+GeneratedInput generate_day2(double scale, rng_t &rng)
+{
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(1000, scale); i < n; ++i) {
+    const auto min = uniform(rng, 1, 5);
+    const auto max = uniform(rng, min + 1, min + 10);
+    const auto letter = static_cast<char>('a' + uniform(rng, 0, 7));
+    std::string password(uniform(rng, max, max + 6), 'a');
+    for (auto &c : password) c = chance(rng, 0.3) ? letter : static_cast<char>('a' + uniform(rng, 0, 7));
+    result.text += fmt::format("{}-{} {}: {}\n", min, max, letter, password);
+  }
+  return result;
+}
+
+GeneratedInput generate_day3(double scale, rng_t &rng)
+{
+  GeneratedInput result;
+  for (std::size_t row = 0, n = scaled(323, scale); row < n; ++row) {
+    for (int column = 0; column < 31; ++column) {
+      result.text.push_back(chance(rng, 0.25) ? '#' : '.');
+    }
+    result.text.push_back('\n');
+  }
+  return result;
+}
+
+GeneratedInput generate_day4(double scale, rng_t &rng)
+{
+  const std::vector<std::string> colors{ "amb", "blu", "brn", "gry", "grn", "hzl", "oth", "xry", "zzz" };
+  const auto digits = [&](int n) {
+    std::string s(n, '0');
+    for (auto &c : s) c = static_cast<char>('0' + uniform(rng, 0, 9));
+    return s;
+  };
+  const auto hex = [&] {
+    std::string s(6, '0');
+    for (auto &c : s) c = "0123456789abcdef"[uniform(rng, 0, 15)];
+    return s;
+  };
+  const auto value = [&](std::string_view tag) -> std::string {
+    const bool valid = chance(rng, 0.85);
+    if (tag == "byr") return fmt::format("{}", valid ? uniform(rng, 1920, 2002) : uniform(rng, 1900, 2030));
+    if (tag == "iyr") return fmt::format("{}", valid ? uniform(rng, 2010, 2020) : uniform(rng, 2000, 2030));
+    if (tag == "eyr") return fmt::format("{}", valid ? uniform(rng, 2020, 2030) : uniform(rng, 2010, 2040));
+    if (tag == "hgt") {
+      if (chance(rng, 0.5)) return fmt::format("{}cm", valid ? uniform(rng, 150, 193) : uniform(rng, 100, 200));
+      return fmt::format("{}{}", valid ? uniform(rng, 59, 76) : uniform(rng, 40, 90), valid ? "in" : "");
+    }
+    if (tag == "hcl") return valid ? "#" + hex() : hex();
+    if (tag == "ecl") return valid ? pick(rng, colors) : "xyz";
+    if (tag == "pid") return digits(valid ? 9 : static_cast<int>(uniform(rng, 8, 10)));
+    return fmt::format("{}", uniform(rng, 100, 350));
+  };
+
+  constexpr std::array tags{ "byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid" };
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(290, scale); i < n; ++i) {
+    std::vector<std::string> fields;
+    for (const auto tag : tags) {
+      if (chance(rng, std::string_view{ tag } == "cid" ? 0.5 : 0.93)) {
+        fields.push_back(fmt::format("{}:{}", tag, value(tag)));
+      }
+    }
+    std::shuffle(fields.begin(), fields.end(), rng);
+    if (i > 0) result.text.push_back('\n');
+    for (std::size_t f = 0; f < fields.size(); ++f) {
+      result.text += fields[f];
+      result.text.push_back(f + 1 == fields.size() || chance(rng, 0.3) ? '\n' : ' ');
+    }
+  }
+  return result;
+}
+
+// Boarding passes grow beyond the 10 characters of the puzzle once there are
+// more seats than 10 bits can address.
+GeneratedInput generate_day5(double scale, rng_t &rng)
+{
+  const auto n = scaled(850, scale);
+  int bits = 10;
+  while ((std::size_t{ 1 } << bits) < n + 2) ++bits;
+  const auto first = uniform(rng, 1, static_cast<long long>((std::size_t{ 1 } << bits) - n - 1));
+  const auto missing = first + uniform(rng, 1, static_cast<long long>(n) - 2);
+
+  std::vector<long long> ids;
+  for (auto id = first; id < first + static_cast<long long>(n); ++id) {
+    if (id != missing) ids.push_back(id);
+  }
+  std::shuffle(ids.begin(), ids.end(), rng);
+
+  GeneratedInput result;
+  for (const auto id : ids) {
+    for (int bit = bits - 1; bit >= 0; --bit) {
+      const bool set = (id >> bit) & 1;
+      result.text.push_back(bit >= 3 ? (set ? 'B' : 'F') : (set ? 'R' : 'L'));
+    }
+    result.text.push_back('\n');
+  }
+  return result;
+}
+
+GeneratedInput generate_day6(double scale, rng_t &rng)
+{
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(490, scale); i < n; ++i) {
+    std::string group_letters;
+    for (char c = 'a'; c <= 'z'; ++c) {
+      if (chance(rng, 0.4)) group_letters.push_back(c);
+    }
+    if (group_letters.empty()) group_letters.push_back('a');
+
+    if (i > 0) result.text.push_back('\n');
+    for (auto person = uniform(rng, 1, 5); person > 0; --person) {
+      std::string answers;
+      for (const auto c : group_letters) {
+        if (chance(rng, 0.8)) answers.push_back(c);
+      }
+      if (answers.empty()) answers.push_back(group_letters.front());
+      std::shuffle(answers.begin(), answers.end(), rng);
+      result.text += answers + '\n';
+    }
+  }
+  return result;
+}
+
+// Bags form a layered DAG, so containment depth stays bounded while the
+// number of rules grows with the scale.
+GeneratedInput generate_day7(double scale, rng_t &rng)
+{
+  static const std::vector<std::string> adjectives{ "light", "dark", "bright", "muted", "faded", "dotted", "vibrant", "dull", "wavy", "plaid", "striped", "clear", "drab", "dim", "mirrored", "posh" };
+  static const std::vector<std::string> colors{ "red", "orange", "white", "yellow", "olive", "plum", "blue", "black", "teal", "cyan", "lime", "tan", "salmon", "violet", "magenta", "coral" };
+  const auto name = [](std::size_t i) {
+    const auto combinations = adjectives.size() * colors.size();
+    auto adjective = adjectives[i % adjectives.size()];
+    if (i >= combinations) adjective += letters(i / combinations);
+    return adjective + ' ' + colors[(i / adjectives.size()) % colors.size()];
+  };
+
+  constexpr int n_layers = 6;
+  const auto width = scaled(100, scale);
+  const auto shiny_gold = 2 * width + uniform(rng, 0, static_cast<long long>(width) - 1);
+  std::vector<std::string> names(n_layers * width);
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    names[i] = i == shiny_gold ? "shiny gold" : name(i);
+  }
+
+  std::vector<std::string> lines;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    const auto layer = i / width;
+    std::vector<std::size_t> children;
+    if (i == width) children.push_back(shiny_gold);
+    if (layer + 1 < n_layers) {
+      for (auto k = uniform(rng, i == shiny_gold ? 1 : 0, 4); k > 0; --k) {
+        const auto child = (layer + 1) * width + uniform(rng, 0, static_cast<long long>(width) - 1);
+        if (std::find(children.begin(), children.end(), child) == children.end()) children.push_back(child);
+      }
+    }
+    if (children.empty()) {
+      lines.push_back(fmt::format("{} bags contain no other bags.\n", names[i]));
+      continue;
+    }
+    std::string line = names[i] + " bags contain ";
+    for (const auto child : children) {
+      const auto count = uniform(rng, 1, 5);
+      if (child != children.front()) line += ", ";
+      line += fmt::format("{} {} bag{}", count, names[child], count > 1 ? "s" : "");
+    }
+    lines.push_back(line + ".\n");
+  }
+  std::shuffle(lines.begin(), lines.end(), rng);
+
+  GeneratedInput result;
+  for (const auto &line : lines) result.text += line;
+  return result;
+}
+
+// Control only moves forward apart from a single backwards jmp that every path
+// reaches, so flipping that jmp is the one repair that terminates.
+GeneratedInput generate_day8(double scale, rng_t &rng)
+{
+  const auto n = static_cast<long long>(std::max<std::size_t>(20, scaled(650, scale)));
+  const auto loop_jump = uniform(rng, n / 2, n - 6);
+
+  GeneratedInput result;
+  for (long long i = 0; i < n; ++i) {
+    if (i == loop_jump) {
+      result.text += fmt::format("jmp {}\n", signed_number(-uniform(rng, 1, i)));
+    } else if (const auto kind = uniform(rng, 0, 9); kind < 5) {
+      result.text += fmt::format("acc {}\n", signed_number(uniform(rng, -50, 50)));
+    } else if (kind < 7 || (i >= loop_jump - 5 && i < loop_jump)) {
+      result.text += fmt::format("nop {}\n", signed_number(-uniform(rng, 0, std::min(i, 100ll))));
+    } else {
+      result.text += fmt::format("jmp {}\n", signed_number(uniform(rng, 1, 5)));
+    }
+  }
+  return result;
+}
+
+// The contiguous range for part 2 sits in the all-positive start of the
+// preamble; later values may be negative so that magnitudes stay bounded.
+GeneratedInput generate_day9(double scale, rng_t &rng)
+{
+  constexpr std::size_t preamble = 25;
+  constexpr long long bound = 1'000'000'000'000;
+  const auto n = std::max<std::size_t>(preamble + 2, scaled(1000, scale));
+
+  std::vector<long long> values(100);
+  std::iota(values.begin(), values.end(), 1);
+  std::shuffle(values.begin(), values.end(), rng);
+  values.resize(12);
+  for (long long v = -100; values.size() < preamble; v = uniform(rng, -100, 100)) {
+    if (v != 0 && std::find(values.begin(), values.end(), v) == values.end()) values.push_back(v);
+  }
+  const auto invalid = std::accumulate(values.begin() + 3, values.begin() + 8, 0ll);
+
+  const auto is_sum = [&](long long value) {
+    for (auto i = values.size() - preamble; i < values.size(); ++i) {
+      for (auto j = i + 1; j < values.size(); ++j) {
+        if (values[i] != values[j] && values[i] + values[j] == value) return true;
+      }
+    }
+    return false;
+  };
+  // The pair closest to a random target keeps the values spread around
+  // zero; a sum built from one random member drifts away once the window
+  // holds values of a single sign.
+  const auto next_valid = [&] {
+    const auto target = uniform(rng, -bound, bound);
+    const auto window_begin = values.end() - preamble;
+    auto best = std::optional<long long>{};
+    for (auto i = window_begin; i != values.end(); ++i) {
+      for (auto j = i + 1; j != values.end(); ++j) {
+        if (*i == *j) continue;
+        if (!best || std::abs(*i + *j - target) < std::abs(*best - target)) best = *i + *j;
+      }
+    }
+    return *best;
+  };
+
+  while (values.size() + 1 < n || is_sum(invalid)) {
+    values.push_back(next_valid());
+  }
+  values.push_back(invalid);
+
+  GeneratedInput result;
+  for (const auto v : values) result.text += fmt::format("{}\n", v);
+  return result;
+}
+
+GeneratedInput generate_day10(double scale, rng_t &rng)
+{
+  std::vector<long long> adapters;
+  long long current = 0;
+  int run = 0;
+  for (std::size_t i = 0, n = scaled(100, scale); i < n; ++i) {
+    const bool small_gap = run < 4 && chance(rng, 0.65);
+    run = small_gap ? run + 1 : 0;
+    current += small_gap ? 1 : 3;
+    adapters.push_back(current);
+  }
+  std::shuffle(adapters.begin(), adapters.end(), rng);
+
+  GeneratedInput result;
+  for (const auto a : adapters) result.text += fmt::format("{}\n", a);
+  return result;
+}
+
+// Runs the seating rules on the layout ('L' seat, '.' floor) and returns the
+// seats that still change after the round limit; empty once it settles.
+std::vector<std::size_t> unsettled_seats(const std::vector<char> &layout, long long rows, long long columns, bool line_of_sight)
+{
+  const auto tolerance = line_of_sight ? 5 : 4;
+  std::vector<char> occupied(layout.size(), 0);
+  std::vector<char> next(layout.size(), 0);
+  std::vector<std::size_t> changed;
+  for (long long round = 0, limit = 4 * (rows + columns) + 100; round < limit; ++round) {
+    changed.clear();
+    for (long long r = 0; r < rows; ++r) {
+      for (long long c = 0; c < columns; ++c) {
+        const auto i = static_cast<std::size_t>(r * columns + c);
+        if (layout[i] != 'L') continue;
+        int neighbours = 0;
+        for (int dr = -1; dr <= 1; ++dr) {
+          for (int dc = -1; dc <= 1; ++dc) {
+            if (dr == 0 && dc == 0) continue;
+            auto nr = r + dr;
+            auto nc = c + dc;
+            while (line_of_sight && nr >= 0 && nr < rows && nc >= 0 && nc < columns && layout[nr * columns + nc] != 'L') {
+              nr += dr;
+              nc += dc;
+            }
+            if (nr >= 0 && nr < rows && nc >= 0 && nc < columns) neighbours += occupied[nr * columns + nc];
+          }
+        }
+        next[i] = occupied[i] ? neighbours < tolerance : neighbours == 0;
+        if (next[i] != occupied[i]) changed.push_back(i);
+      }
+    }
+    if (changed.empty()) break;
+    std::swap(occupied, next);
+  }
+  return changed;
+}
+
+// Random layouts can oscillate forever under the seating rules, so seats
+// that keep flipping are replaced by floor until both rule sets settle.
+GeneratedInput generate_day11(double scale, rng_t &rng)
+{
+  const auto rows = static_cast<long long>(scaled_side(92, scale));
+  const auto columns = static_cast<long long>(scaled_side(95, scale));
+  std::vector<char> layout(rows * columns);
+  for (auto &cell : layout) cell = chance(rng, 0.85) ? 'L' : '.';
+  for (bool settled = false; !settled;) {
+    settled = true;
+    for (const auto line_of_sight : { false, true }) {
+      for (const auto seat : unsettled_seats(layout, rows, columns, line_of_sight)) {
+        layout[seat] = '.';
+        settled = false;
+      }
+    }
+  }
+
+  GeneratedInput result;
+  for (long long row = 0; row < rows; ++row) {
+    result.text.append(layout.begin() + row * columns, layout.begin() + (row + 1) * columns);
+    result.text.push_back('\n');
+  }
+  return result;
+}
+
+GeneratedInput generate_day12(double scale, rng_t &rng)
+{
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(780, scale); i < n; ++i) {
+    if (const auto kind = uniform(rng, 0, 6); kind < 2) {
+      result.text += fmt::format("{}{}\n", kind == 0 ? 'L' : 'R', 90 * uniform(rng, 1, 3));
+    } else {
+      result.text += fmt::format("{}{}\n", "NSEWF"[kind - 2], uniform(rng, 1, 100));
+    }
+  }
+  return result;
+}
+
+// The bus ids are fixed primes whose product still fits into 64 bits; the
+// schedule gets longer with the scale.
+GeneratedInput generate_day13(double scale, rng_t &rng)
+{
+  constexpr std::array<int, 9> buses{ 13, 17, 19, 23, 29, 37, 41, 401, 601 };
+  std::vector<std::string> schedule(std::max<std::size_t>(buses.size(), scaled(70, scale)), "x");
+  std::vector<std::size_t> slots(schedule.size());
+  std::iota(slots.begin(), slots.end(), 0);
+  std::shuffle(slots.begin() + 1, slots.end(), rng);
+  for (std::size_t i = 0; i < buses.size(); ++i) {
+    schedule[slots[i]] = fmt::format("{}", buses[i]);
+  }
+
+  GeneratedInput result;
+  result.text = fmt::format("{}\n", uniform(rng, 1'000'000, 1'010'000));
+  for (std::size_t i = 0; i < schedule.size(); ++i) {
+    result.text += schedule[i];
+    result.text.push_back(i + 1 == schedule.size() ? '\n' : ',');
+  }
+  return result;
+}
+
+GeneratedInput generate_day14(double scale, rng_t &rng)
+{
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(100, scale); i < n; ++i) {
+    std::string mask(36, '0');
+    for (auto &c : mask) c = chance(rng, 0.5) ? '1' : '0';
+    for (auto floating = uniform(rng, 4, 9); floating > 0; --floating) {
+      mask[uniform(rng, 0, 35)] = 'X';
+    }
+    result.text += "mask = " + mask + '\n';
+    for (auto writes = uniform(rng, 1, 6); writes > 0; --writes) {
+      result.text += fmt::format("mem[{}] = {}\n", uniform(rng, 1, 65535), uniform(rng, 1, 999'999'999));
+    }
+  }
+  return result;
+}
+
+GeneratedInput generate_day15(double scale, rng_t &rng)
+{
+  std::vector<int> start(10);
+  std::iota(start.begin(), start.end(), 0);
+  std::shuffle(start.begin(), start.end(), rng);
+  start.resize(6);
+
+  GeneratedInput result;
+  for (std::size_t i = 0; i < start.size(); ++i) {
+    result.text += fmt::format("{}{}", start[i], i + 1 == start.size() ? '\n' : ',');
+  }
+  result.options.emplace_back("DAY15_TURNS", fmt::format("{}", scaled(30'000'000, scale)));
+  return result;
+}
+
+// Field of rank k accepts the value blocks 0..k, so the column of rank k can
+// only be one of the fields of rank k and above and they resolve one by one.
+GeneratedInput generate_day16(double scale, rng_t &rng)
+{
+  static const std::vector<std::string> names{
+    "departure location", "departure station", "departure platform", "departure track", "departure date",
+    "departure time", "arrival location", "arrival station", "arrival platform", "arrival track",
+    "class", "duration", "price", "route", "row", "seat", "train", "type", "wagon", "zone"
+  };
+  const auto n = names.size();
+  std::vector<std::size_t> rank(n);
+  std::iota(rank.begin(), rank.end(), 0);
+  std::shuffle(rank.begin(), rank.end(), rng);
+  std::vector<std::size_t> column_field(n);
+  std::iota(column_field.begin(), column_field.end(), 0);
+  std::shuffle(column_field.begin(), column_field.end(), rng);
+
+  const auto block_value = [&](std::size_t block) { return static_cast<long long>(5 * block) + uniform(rng, 1, 5); };
+  const auto ticket = [&](bool exact, bool invalid) {
+    std::string line;
+    const auto broken = uniform(rng, 0, static_cast<long long>(n) - 1);
+    for (std::size_t column = 0; column < n; ++column) {
+      const auto field_rank = rank[column_field[column]];
+      const auto value = invalid && static_cast<long long>(column) == broken
+                           ? uniform(rng, 500, 999)
+                           : block_value(exact ? field_rank : uniform(rng, 0, static_cast<long long>(field_rank)));
+      line += fmt::format("{}{}", value, column + 1 == n ? '\n' : ',');
+    }
+    return line;
+  };
+
+  GeneratedInput result;
+  for (std::size_t field = 0; field < n; ++field) {
+    const auto k = rank[field];
+    result.text += fmt::format("{}: 1-{} or {}-{}\n", names[field], 5 * (k + 1), 200 + 7 * k, 203 + 7 * k);
+  }
+  result.text += "\nyour ticket:\n" + ticket(false, false);
+  result.text += "\nnearby tickets:\n" + ticket(true, false);
+  for (std::size_t i = 1, count = scaled(240, scale); i < count; ++i) {
+    result.text += ticket(false, chance(rng, 0.25));
+  }
+  return result;
+}
+
+GeneratedInput generate_day17(double scale, rng_t &rng)
+{
+  const auto side = scaled_side(8, scale);
+  GeneratedInput result;
+  for (std::size_t row = 0; row < side; ++row) {
+    for (std::size_t column = 0; column < side; ++column) {
+      result.text.push_back(chance(rng, 0.5) ? '#' : '.');
+    }
+    result.text.push_back('\n');
+  }
+  return result;
+}
+
+// Expressions are regenerated until the product of (digit + 1) over all
+// digits, an upper bound of either evaluation order, stays below 10^12.
+GeneratedInput generate_day18(double scale, rng_t &rng)
+{
+  const auto expression = [&](auto &&self, int depth, double &bound) -> std::string {
+    std::string result;
+    for (auto terms = uniform(rng, 2, depth == 0 ? 6 : 4); terms > 0; --terms) {
+      if (depth < 2 && chance(rng, 0.3)) {
+        result += '(' + self(self, depth + 1, bound) + ')';
+      } else {
+        const auto digit = uniform(rng, 1, 9);
+        bound *= static_cast<double>(digit + 1);
+        result += static_cast<char>('0' + digit);
+      }
+      if (terms > 1) result += chance(rng, 0.5) ? " + " : " * ";
+    }
+    return result;
+  };
+
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(370, scale); i < n;) {
+    double bound = 1;
+    const auto line = expression(expression, 0, bound);
+    if (bound < 1e12) {
+      result.text += line + '\n';
+      ++i;
+    }
+  }
+  return result;
+}
+
+// Rules 42 and 31 split the strings of length 8 by a parity of pairs, with
+// the usual 0: 8 11 structure on top.
+GeneratedInput generate_day19(double scale, rng_t &rng)
+{
+  // q1 holds for differing pairs, q(k + 1) when both halves agree on qk.
+  const auto parity = [](auto &&self, std::string_view s) -> bool {
+    if (s.size() == 2) return s[0] != s[1];
+    return self(self, s.substr(0, s.size() / 2)) == self(self, s.substr(s.size() / 2));
+  };
+  const auto chunk = [&](bool rule_42) {
+    std::string s(8, 'a');
+    for (auto &c : s) c = chance(rng, 0.5) ? 'a' : 'b';
+    if (parity(parity, s) != rule_42) s[0] = s[0] == 'a' ? 'b' : 'a';
+    return s;
+  };
+
+  std::vector<std::string> lines{
+    "0: 8 11", "8: 42", "11: 42 31", "1: \"a\"", "2: \"b\"",
+    "3: 1 2 | 2 1", "4: 1 1 | 2 2", "5: 3 3 | 4 4", "6: 3 4 | 4 3",
+    "42: 5 5 | 6 6", "31: 5 6 | 6 5"
+  };
+  std::shuffle(lines.begin(), lines.end(), rng);
+
+  GeneratedInput result;
+  for (const auto &line : lines) result.text += line + '\n';
+  result.text += '\n';
+  for (std::size_t i = 0, n = scaled(450, scale); i < n; ++i) {
+    std::string message;
+    if (chance(rng, 0.2)) {
+      message = random_word(rng, 16, 40);
+      for (auto &c : message) c = c < 'n' ? 'a' : 'b';
+    } else {
+      const auto n_31 = uniform(rng, 1, 3);
+      const auto n_42 = uniform(rng, chance(rng, 0.8) ? n_31 + 1 : 1, n_31 + 3);
+      for (auto k = n_42; k > 0; --k) message += chunk(true);
+      for (auto k = n_31; k > 0; --k) message += chunk(false);
+    }
+    result.text += message + '\n';
+  }
+  return result;
+}
+
+// Tiles are cut from a random image with hidden sea monsters. All tile edges
+// are distinct and not palindromes, which caps the puzzle at 12x12 tiles.
+GeneratedInput generate_day20(double scale, rng_t &rng)
+{
+  const auto side = std::min<std::size_t>(12, scaled_side(12, scale));
+  const auto reverse_bits = [](unsigned edge) {
+    unsigned result = 0;
+    for (int i = 0; i < 10; ++i) result |= ((edge >> i) & 1u) << (9 - i);
+    return result;
+  };
+
+  std::vector corners(side + 1, std::vector<unsigned>(side + 1));
+  for (auto &row : corners) {
+    for (auto &c : row) c = static_cast<unsigned>(uniform(rng, 0, 1));
+  }
+  std::set<unsigned> used;
+  const auto edge = [&](unsigned first, unsigned last) {
+    for (int attempt = 0; attempt < 100'000; ++attempt) {
+      const auto e = first | (static_cast<unsigned>(uniform(rng, 0, 255)) << 1) | (last << 9);
+      const auto canonical = std::min(e, reverse_bits(e));
+      if (e != reverse_bits(e) && used.insert(canonical).second) return e;
+    }
+    throw std::runtime_error{ "Ran out of distinct tile edges." };
+  };
+  // horizontal[r][c] is the top border of tile (r, c), vertical[r][c] its left.
+  std::vector horizontal(side + 1, std::vector<unsigned>(side));
+  std::vector vertical(side, std::vector<unsigned>(side + 1));
+  for (std::size_t r = 0; r <= side; ++r) {
+    for (std::size_t c = 0; c < side; ++c) horizontal[r][c] = edge(corners[r][c], corners[r][c + 1]);
+  }
+  for (std::size_t r = 0; r < side; ++r) {
+    for (std::size_t c = 0; c <= side; ++c) vertical[r][c] = edge(corners[r][c], corners[r + 1][c]);
+  }
+
+  constexpr std::array<std::string_view, 3> monster{
+    "                  # ",
+    "#    ##    ##    ###",
+    " #  #  #  #  #  #   "
+  };
+  const auto image_side = 8 * side;
+  std::vector image(image_side, std::vector<bool>(image_side));
+  for (auto &row : image) {
+    for (std::size_t c = 0; c < row.size(); ++c) row[c] = chance(rng, 0.3);
+  }
+  for (std::size_t r = 0; r + monster.size() <= image_side; r += monster.size() + uniform(rng, 0, 4)) {
+    for (std::size_t c = uniform(rng, 0, 4); c + monster[0].size() <= image_side; c += monster[0].size() + uniform(rng, 1, 10)) {
+      for (std::size_t mr = 0; mr < monster.size(); ++mr) {
+        for (std::size_t mc = 0; mc < monster[mr].size(); ++mc) {
+          if (monster[mr][mc] == '#') image[r + mr][c + mc] = true;
+        }
+      }
+    }
+  }
+
+  std::vector<int> ids(9000);
+  std::iota(ids.begin(), ids.end(), 1000);
+  std::shuffle(ids.begin(), ids.end(), rng);
+
+  GeneratedInput result;
+  for (std::size_t r = 0; r < side; ++r) {
+    for (std::size_t c = 0; c < side; ++c) {
+      std::array<std::array<bool, 10>, 10> tile;
+      for (int i = 0; i < 10; ++i) {
+        tile[0][i] = (horizontal[r][c] >> i) & 1u;
+        tile[9][i] = (horizontal[r + 1][c] >> i) & 1u;
+        tile[i][0] = (vertical[r][c] >> i) & 1u;
+        tile[i][9] = (vertical[r][c + 1] >> i) & 1u;
+      }
+      for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) tile[i + 1][j + 1] = image[8 * r + i][8 * c + j];
+      }
+
+      for (auto turns = uniform(rng, 0, 3); turns > 0; --turns) {
+        auto rotated = tile;
+        for (int i = 0; i < 10; ++i) {
+          for (int j = 0; j < 10; ++j) rotated[j][9 - i] = tile[i][j];
+        }
+        tile = rotated;
+      }
+      if (chance(rng, 0.5)) {
+        for (auto &row : tile) std::reverse(row.begin(), row.end());
+      }
+
+      result.text += fmt::format("Tile {}:\n", ids[r * side + c]);
+      for (const auto &row : tile) {
+        for (const auto pixel : row) result.text.push_back(pixel ? '#' : '.');
+        result.text.push_back('\n');
+      }
+      result.text.push_back('\n');
+    }
+  }
+  return result;
+}
+
+// Every allergen is listed on enough foods that intersecting their
+// ingredients leaves only its own ingredient.
+GeneratedInput generate_day21(double scale, rng_t &rng)
+{
+  static const std::vector<std::string> allergens{ "dairy", "eggs", "fish", "nuts", "peanuts", "sesame", "soy", "wheat" };
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> ingredients;
+  while (ingredients.size() < 200) {
+    if (auto word = random_word(rng, 4, 8); seen.insert(word).second) ingredients.push_back(std::move(word));
+  }
+
+  GeneratedInput result;
+  const auto n = std::max<std::size_t>(allergens.size() * 10, scaled(80, scale));
+  for (std::size_t i = 0; i < n; ++i) {
+    std::vector<std::size_t> listed;
+    listed.push_back(i % allergens.size());
+    for (std::size_t a = 0; a < allergens.size(); ++a) {
+      if (a != listed.front() && chance(rng, 0.15)) listed.push_back(a);
+    }
+    std::sort(listed.begin(), listed.end());
+
+    std::vector<std::size_t> food;
+    for (std::size_t a = 0; a < allergens.size(); ++a) {
+      if (std::binary_search(listed.begin(), listed.end(), a) || chance(rng, 0.3)) food.push_back(a);
+    }
+    for (auto k = uniform(rng, 5, 60); k > 0; --k) {
+      const auto ingredient = static_cast<std::size_t>(uniform(rng, static_cast<long long>(allergens.size()), 199));
+      if (std::find(food.begin(), food.end(), ingredient) == food.end()) food.push_back(ingredient);
+    }
+    std::shuffle(food.begin(), food.end(), rng);
+
+    for (const auto ingredient : food) result.text += ingredients[ingredient] + ' ';
+    result.text += "(contains ";
+    for (const auto a : listed) {
+      result.text += allergens[a];
+      result.text += a == listed.back() ? ")\n" : ", ";
+    }
+  }
+  return result;
+}
+
+// Decks keep the size of the puzzle at every scale. Recursive combat does
+// not grow linearly with the deck size: at 30 cards a deck a game can
+// already take tens of seconds.
+GeneratedInput generate_day22(double, rng_t &rng)
+{
+  constexpr std::size_t n = 25;
+  std::vector<std::size_t> cards(2 * n);
+  std::iota(cards.begin(), cards.end(), 1);
+  std::shuffle(cards.begin(), cards.end(), rng);
+
+  GeneratedInput result;
+  result.text = "Player 1:\n";
+  for (std::size_t i = 0; i < n; ++i) result.text += fmt::format("{}\n", cards[i]);
+  result.text += "\nPlayer 2:\n";
+  for (std::size_t i = n; i < 2 * n; ++i) result.text += fmt::format("{}\n", cards[i]);
+  return result;
+}
+
+GeneratedInput generate_day23(double scale, rng_t &rng)
+{
+  std::string cups = "123456789";
+  std::shuffle(cups.begin(), cups.end(), rng);
+
+  GeneratedInput result;
+  result.text = cups + '\n';
+  result.options.emplace_back("DAY23_CUPS", fmt::format("{}", scaled(1'000'000, scale)));
+  result.options.emplace_back("DAY23_MOVES", fmt::format("{}", scaled(10'000'000, scale)));
+  return result;
+}
+
+GeneratedInput generate_day24(double scale, rng_t &rng)
+{
+  constexpr std::array<std::string_view, 6> directions{ "e", "se", "sw", "w", "nw", "ne" };
+  GeneratedInput result;
+  for (std::size_t i = 0, n = scaled(400, scale); i < n; ++i) {
+    for (auto steps = uniform(rng, 15, 25); steps > 0; --steps) {
+      result.text += directions[uniform(rng, 0, 5)];
+    }
+    result.text += '\n';
+  }
+  return result;
+}
+
+GeneratedInput generate_day25(double scale, rng_t &rng)
+{
+  constexpr long long modulus = 20201227;
+  const auto max_loop = std::min<long long>(modulus - 1, static_cast<long long>(scaled(2'000'000, scale)));
+  const auto public_key = [&] {
+    long long key = 1;
+    for (auto loop = uniform(rng, max_loop / 2, max_loop); loop > 0; --loop) {
+      key = (key * 7) % modulus;
+    }
+    return key;
+  };
+
+  GeneratedInput result;
+  result.text = fmt::format("{}\n{}\n", public_key(), public_key());
+  return result;
+}
+
+using generator_t = GeneratedInput (*)(double, rng_t &);
+constexpr std::array<generator_t, 25> generators{
+  generate_day1, generate_day2, generate_day3, generate_day4, generate_day5,
+  generate_day6, generate_day7, generate_day8, generate_day9, generate_day10,
+  generate_day11, generate_day12, generate_day13, generate_day14, generate_day15,
+  generate_day16, generate_day17, generate_day18, generate_day19, generate_day20,
+  generate_day21, generate_day22, generate_day23, generate_day24, generate_day25
+};
+
+}// namespace
+
+GeneratedInput generate_input(int day, double scale, std::uint64_t seed)
+{
+  if (day < 1 || day > static_cast<int>(generators.size())) {
+    throw std::out_of_range{ "There is no generator for the day." };
+  }
+  rng_t rng{ seed };
+  return generators[day - 1](scale, rng);
+}
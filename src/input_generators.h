@@ -0,0 +1,23 @@
+#ifndef AOC2020_INPUT_GENERATORS_
+#define AOC2020_INPUT_GENERATORS_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct GeneratedInput
+{
+  std::string text;
+  // Overrides for parameters that live outside of the input, as
+  // (option name, value) pairs to be exported as AOC_<name>.
+  std::vector<std::pair<std::string, std::string>> options;
+};
+
+// Generates a valid puzzle input for the day. A scale of 1 produces roughly
+// the size of the original puzzle inputs; the work grows about linearly with
+// the scale. Day20 grids stop growing at 12x12 tiles, and day22 decks keep
+// the puzzle size at every scale.
+GeneratedInput generate_input(int day, double scale, std::uint64_t seed);
+
+#endif // AOC2020_INPUT_GENERATORS_
@@ -0,0 +1,105 @@
+#include "instrumentation.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+thread_local Instrumentation *active_instrumentation = nullptr;
+
+std::string json_escape(std::string_view s)
+{
+  std::string result;
+  result.reserve(s.size());
+  for (const auto c : s) {
+    if (c == '"' || c == '\\') {
+      result.push_back('\\');
+      result.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      result += fmt::format("\\u{:04x}", static_cast<int>(c));
+    } else {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+
+}// namespace
+
+void Instrumentation::record(std::string_view phase, std::chrono::nanoseconds elapsed)
+{
+  auto it = std::find_if(m_phases.begin(), m_phases.end(), [phase](const auto &p) { return p.name == phase; });
+  if (it == m_phases.end()) {
+    it = m_phases.insert(m_phases.end(), PhaseRecord{ std::string{ phase } });
+  }
+  it->total += elapsed;
+  ++it->repetitions;
+}
+
+std::string Instrumentation::to_json(std::string_view run, std::string_view input, std::size_t repetitions) const
+{
+  std::string result = fmt::format(
+    R"({{"run":"{}","input":"{}","repetitions":{},"phases":[)",
+    json_escape(run),
+    json_escape(input),
+    repetitions);
+  std::chrono::nanoseconds total{ 0 };
+  for (const auto &p : m_phases) {
+    if (&p != &m_phases.front()) result.push_back(',');
+    result += fmt::format(
+      R"({{"name":"{}","repetitions":{},"total_ns":{},"mean_ns":{}}})",
+      json_escape(p.name),
+      p.repetitions,
+      p.total.count(),
+      p.repetitions > 0 ? p.total.count() / static_cast<long long>(p.repetitions) : 0);
+    total += p.total;
+  }
+  result += fmt::format(R"(],"total_ns":{}}})", total.count());
+  return result;
+}
+
+InstrumentationScope::InstrumentationScope(Instrumentation &instrumentation)
+  : m_previous{ std::exchange(active_instrumentation, &instrumentation) }
+{}
+
+InstrumentationScope::~InstrumentationScope()
+{
+  active_instrumentation = m_previous;
+}
+
+Instrumentation *current_instrumentation()
+{
+  return active_instrumentation;
+}
+
+InstrumentationOptions parse_instrumentation_options(int &argc, char **argv)
+{
+  InstrumentationOptions options;
+  if (const auto *env = std::getenv("AOC_TIMING"); env != nullptr && *env != '\0' && std::string_view{ env } != "0") {
+    options.enabled = true;
+  }
+
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{ argv[i] };
+    if (arg == "--timing") {
+      options.enabled = true;
+    } else if (arg == "--repeat" && i + 1 < argc) {
+      const std::string_view value{ argv[++i] };
+      const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), options.repetitions);
+      if (ec != std::errc{} || ptr != value.data() + value.size() || options.repetitions == 0) {
+        throw std::invalid_argument{ "--repeat expects a positive number." };
+      }
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argv[kept] = nullptr;
+  argc = kept;
+  return options;
+}
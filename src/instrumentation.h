@@ -0,0 +1,98 @@
+#ifndef AOC2020_INSTRUMENTATION_
+#define AOC2020_INSTRUMENTATION_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct PhaseRecord
+{
+  std::string name;
+  std::chrono::nanoseconds total{ 0 };
+  std::size_t repetitions{ 0 };
+};
+
+// Accumulates the time spent in every named phase of a run, in the order the
+// phases were first entered.
+class Instrumentation
+{
+public:
+  void record(std::string_view phase, std::chrono::nanoseconds elapsed);
+
+  const std::vector<PhaseRecord> &phases() const
+  {
+    return m_phases;
+  }
+
+  // One JSON object on a single line, suitable for JSON Lines logs.
+  std::string to_json(std::string_view run, std::string_view input, std::size_t repetitions) const;
+
+private:
+  std::vector<PhaseRecord> m_phases;
+};
+
+// Makes the instrumentation the target of timed() on the current thread for
+// the lifetime of the scope.
+class InstrumentationScope
+{
+public:
+  explicit InstrumentationScope(Instrumentation &instrumentation);
+  ~InstrumentationScope();
+
+  InstrumentationScope(const InstrumentationScope &) = delete;
+  InstrumentationScope &operator=(const InstrumentationScope &) = delete;
+
+private:
+  Instrumentation *m_previous;
+};
+
+Instrumentation *current_instrumentation();
+
+class PhaseTimer
+{
+public:
+  explicit PhaseTimer(std::string_view phase)
+    : m_instrumentation{ current_instrumentation() }
+    , m_phase{ phase }
+  {
+    if (m_instrumentation) m_start = std::chrono::steady_clock::now();
+  }
+
+  ~PhaseTimer()
+  {
+    if (m_instrumentation) {
+      m_instrumentation->record(m_phase, std::chrono::steady_clock::now() - m_start);
+    }
+  }
+
+  PhaseTimer(const PhaseTimer &) = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+  Instrumentation *m_instrumentation;
+  std::string_view m_phase;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+// Runs f as the named phase; only measured when an InstrumentationScope is
+// active on this thread.
+template<typename F>
+decltype(auto) timed(std::string_view phase, F &&f)
+{
+  const PhaseTimer timer{ phase };
+  return std::invoke(std::forward<F>(f));
+}
+
+struct InstrumentationOptions
+{
+  bool enabled{ false };
+  std::size_t repetitions{ 1 };
+};
+
+// Enabled by a non-empty AOC_TIMING other than "0" or by --timing; --repeat N
+// runs the solver N times. Recognised flags are removed from argv.
+InstrumentationOptions parse_instrumentation_options(int &argc, char **argv);
+
+#endif // AOC2020_INSTRUMENTATION_
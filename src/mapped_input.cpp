@@ -0,0 +1,140 @@
+#include "mapped_input.h"
+#include "input_file_loader.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AOC2020_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::vector<std::size_t> index_lines(std::string_view data)
+{
+  std::vector<std::size_t> offsets;
+  std::size_t begin = 0;
+  while (begin < data.size()) {
+    offsets.push_back(begin);
+    const auto *end = static_cast<const char *>(std::memchr(data.data() + begin, '\n', data.size() - begin));
+    if (end == nullptr) break;
+    begin = static_cast<std::size_t>(end - data.data()) + 1;
+  }
+  return offsets;
+}
+
+}// namespace
+
+MappedInput::MappedInput(const std::filesystem::path& path)
+{
+  if (is_stdin(path)) {
+    read_stdin();
+    return;
+  }
+#ifdef AOC2020_HAS_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::system_error{ errno, std::generic_category(), "Unable to open " + path.string() };
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    throw std::system_error{ error, std::generic_category(), "Unable to stat " + path.string() };
+  }
+  m_size = static_cast<std::size_t>(info.st_size);
+  if (m_size > 0) {
+    void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      const auto error = errno;
+      ::close(fd);
+      throw std::system_error{ error, std::generic_category(), "Unable to map " + path.string() };
+    }
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(data);
+    m_mapped = true;
+  }
+  ::close(fd);
+#else
+  std::ifstream is{ path, std::ios::binary };
+  if (!is) {
+    throw std::system_error{ errno, std::generic_category(), "Unable to open " + path.string() };
+  }
+  m_buffer.assign(std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{});
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+#endif
+  m_line_offsets = index_lines(view());
+}
+
+MappedInput::~MappedInput()
+{
+  release();
+}
+
+MappedInput::MappedInput(MappedInput&& other) noexcept
+{
+  *this = std::move(other);
+}
+
+MappedInput& MappedInput::operator=(MappedInput&& other) noexcept
+{
+  if (this != &other) {
+    release();
+    m_mapped = std::exchange(other.m_mapped, false);
+    m_size = std::exchange(other.m_size, 0);
+    m_buffer = std::move(other.m_buffer);
+    m_data = m_mapped ? other.m_data : m_buffer.data();
+    other.m_data = nullptr;
+    m_line_offsets = std::move(other.m_line_offsets);
+  }
+  return *this;
+}
+
+std::string_view MappedInput::line(std::size_t index) const
+{
+  const auto begin = m_line_offsets[index];
+  auto end = m_size;
+  if (index + 1 < m_line_offsets.size()) {
+    end = m_line_offsets[index + 1] - 1;
+  } else if (m_data[end - 1] == '\n') {
+    --end;
+  }
+  return std::string_view{ m_data + begin, end - begin };
+}
+
+// Standard input cannot be mapped, so it is read into the buffer.
+void MappedInput::read_stdin()
+{
+  char block[1 << 16];
+  for (std::size_t n; (n = std::fread(block, 1, sizeof(block), stdin)) > 0;) {
+    m_buffer.append(block, n);
+  }
+  if (std::ferror(stdin)) {
+    throw std::system_error{ errno, std::generic_category(), "Unable to read standard input" };
+  }
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+  m_line_offsets = index_lines(view());
+}
+
+void MappedInput::release()
+{
+#ifdef AOC2020_HAS_MMAP
+  if (m_mapped) {
+    ::munmap(const_cast<char *>(m_data), m_size);
+  }
+#endif
+  m_mapped = false;
+  m_data = nullptr;
+  m_size = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef AOC2020_MAPPED_INPUT_
+#define AOC2020_MAPPED_INPUT_
+
+#include <filesystem>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only view of a whole input file. On POSIX systems the file is memory
+// mapped, elsewhere it is read into a single buffer. Views handed out remain
+// valid for as long as the MappedInput is alive. "-" reads standard input.
+class MappedInput
+{
+public:
+  explicit MappedInput(const std::filesystem::path& path);
+  ~MappedInput();
+
+  MappedInput(const MappedInput&) = delete;
+  MappedInput& operator=(const MappedInput&) = delete;
+  MappedInput(MappedInput&& other) noexcept;
+  MappedInput& operator=(MappedInput&& other) noexcept;
+
+  std::string_view view() const
+  {
+    return std::string_view{ m_data, m_size };
+  }
+
+  // Offsets of the first character of every line; a trailing newline does
+  // not start an empty line, in the same way as std::getline.
+  const std::vector<std::size_t>& line_offsets() const
+  {
+    return m_line_offsets;
+  }
+
+  std::size_t line_count() const
+  {
+    return m_line_offsets.size();
+  }
+
+  // The line without its terminating newline.
+  std::string_view line(std::size_t index) const;
+
+  auto lines() const
+  {
+    return std::views::iota(std::size_t{ 0 }, line_count())
+           | std::views::transform([this](std::size_t index) { return line(index); });
+  }
+
+private:
+  void read_stdin();
+  void release();
+
+  const char* m_data{ nullptr };
+  std::size_t m_size{ 0 };
+  bool m_mapped{ false };
+  std::string m_buffer;
+  std::vector<std::size_t> m_line_offsets;
+};
+
+#endif // AOC2020_MAPPED_INPUT_
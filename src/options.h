@@ -0,0 +1,59 @@
+#ifndef AOC2020_OPTIONS_
+#define AOC2020_OPTIONS_
+
+#include <charconv>
+#include <concepts>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tunables that the puzzle input cannot express (turn counts, window sizes)
+// are read from AOC_<NAME> environment variables so scaled runs can override
+// them without changing the command line of every binary.
+template<std::integral T>
+T option(std::string_view name, T fallback)
+{
+  const auto variable = "AOC_" + std::string{ name };
+  const char *value = std::getenv(variable.c_str());
+  if (value == nullptr || *value == '\0') {
+    return fallback;
+  }
+
+  const std::string_view str{ value };
+  T result;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+  if (ec != std::errc{} || ptr != str.data() + str.size()) {
+    throw std::invalid_argument{ variable + " is not a valid number." };
+  }
+  return result;
+}
+
+// Comma-separated list of numbers, e.g. AOC_DAY1_TARGETS=2020,1000.
+template<std::integral T>
+std::vector<T> option_list(std::string_view name, std::vector<T> fallback)
+{
+  const auto variable = "AOC_" + std::string{ name };
+  const char *value = std::getenv(variable.c_str());
+  if (value == nullptr || *value == '\0') {
+    return fallback;
+  }
+
+  std::vector<T> result;
+  for (std::string_view str{ value };;) {
+    const auto comma = str.find(',');
+    const auto item = str.substr(0, comma);
+    T number;
+    const auto [ptr, ec] = std::from_chars(item.data(), item.data() + item.size(), number);
+    if (item.empty() || ec != std::errc{} || ptr != item.data() + item.size()) {
+      throw std::invalid_argument{ variable + " is not a comma-separated list of numbers." };
+    }
+    result.push_back(number);
+    if (comma == std::string_view::npos) break;
+    str.remove_prefix(comma + 1);
+  }
+  return result;
+}
+
+#endif // AOC2020_OPTIONS_
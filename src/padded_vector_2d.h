@@ -1,18 +1,61 @@
 #ifndef PADDED_VECTOR_2D_H
 #define PADDED_VECTOR_2D_H
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
+// Read-only view of the cells around one cell of a grid with a halo.
+// Offsets are not checked and must stay within the halo.
+template <typename T>
+class Neighbourhood
+{
+public:
+  Neighbourhood(const T* center, std::ptrdiff_t stride)
+    : m_center{ center }
+    , m_stride{ stride }
+  {}
+
+  const T& operator()(int row_offset, int column_offset) const
+  {
+    return m_center[row_offset * m_stride + column_offset];
+  }
+
+private:
+  const T* m_center;
+  std::ptrdiff_t m_stride;
+};
+
+// Grid whose reads outside of the data return a padding value. With a halo,
+// that many rings of padding cells are stored around the data, so neighbour
+// reads within the halo need no bounds checks at all.
 template <typename T>
 class PaddedVector2D
 {
 public:
   PaddedVector2D(std::size_t n_cols, T m_padding_value, std::vector<T> raw)
     : m_raw{ std::move(raw) }
+    , m_n_rows{ m_raw.size() / n_cols }
     , m_n_cols{ n_cols }
+    , m_halo{ 0 }
     , m_padding_value{ std::move(m_padding_value) }
   {}
 
+  PaddedVector2D(std::size_t n_cols, T padding_value, const std::vector<T>& raw, std::size_t halo)
+    : m_raw((raw.size() / n_cols + 2 * halo) * (n_cols + 2 * halo), padding_value)
+    , m_n_rows{ raw.size() / n_cols }
+    , m_n_cols{ n_cols }
+    , m_halo{ halo }
+    , m_padding_value{ std::move(padding_value) }
+  {
+    for (std::size_t row = 0; row < m_n_rows; ++row) {
+      std::copy_n(raw.begin() + row * m_n_cols, m_n_cols, m_raw.begin() + index(static_cast<int>(row), 0));
+    }
+  }
+
   const T& at(int row, int column) const
   {
     if (row < 0 || row > rows() - 1 || column < 0 || column > cols() - 1) {
@@ -31,9 +74,45 @@ public:
     }
   }
 
+  // No bounds checks; valid for cells within the halo around the data.
+  const T& unchecked(int row, int column) const
+  {
+    return m_raw[index(row, column)];
+  }
+
+  T& unchecked(int row, int column)
+  {
+    return m_raw[index(row, column)];
+  }
+
+  // The data cells of a row. The halo lies just outside of the span, so
+  // data()[-1] or data()[cols()] are valid reads when there is a halo.
+  std::span<const T> row(int i) const
+  {
+    return std::span<const T>{ m_raw.data() + index(i, 0), m_n_cols };
+  }
+
+  std::span<T> row(int i)
+  {
+    return std::span<T>{ m_raw.data() + index(i, 0), m_n_cols };
+  }
+
+  // Calls f(row, column, neighbourhood) for every data cell in row-major
+  // order, where neighbourhood(dr, dc) reads the cell at that offset.
+  template <typename F>
+  void stencil(F&& f) const
+  {
+    for (int r = 0; r < static_cast<int>(m_n_rows); ++r) {
+      const T* center = row(r).data();
+      for (int c = 0; c < static_cast<int>(m_n_cols); ++c, ++center) {
+        f(r, c, Neighbourhood<T>{ center, stride() });
+      }
+    }
+  }
+
   std::size_t rows() const
   {
-    return m_raw.size() / m_n_cols;
+    return m_n_rows;
   }
 
   std::size_t cols() const
@@ -41,6 +120,17 @@ public:
     return m_n_cols;
   }
 
+  std::size_t halo() const
+  {
+    return m_halo;
+  }
+
+  std::ptrdiff_t stride() const
+  {
+    return static_cast<std::ptrdiff_t>(m_n_cols + 2 * m_halo);
+  }
+
+  // All stored cells, halo included.
   const std::vector<T>& raw() const
   {
     return m_raw;
@@ -49,12 +139,130 @@ public:
 private:
   std::size_t index(int row, int column) const
   {
-    return m_n_cols * row + column;
+    return static_cast<std::size_t>((row + static_cast<int>(m_halo)) * stride() + column + static_cast<int>(m_halo));
   };
 
   std::vector<T> m_raw;
+  std::size_t m_n_rows;
   std::size_t m_n_cols;
+  std::size_t m_halo;
   T m_padding_value;
 };
 
+// Two-state grids are packed 64 cells to a word, with every row starting on
+// a new word. Bit i of a word is the cell in column 64 * word + i. The unused
+// bits at the end of each row hold the padding value, so whole-word reads
+// beyond the last column see the padding just like at() does.
+template <>
+class PaddedVector2D<bool>
+{
+public:
+  using word_t = std::uint64_t;
+  static constexpr std::size_t word_bits = 64;
+
+  PaddedVector2D(std::size_t n_rows, std::size_t n_cols, bool padding_value)
+    : m_n_rows{ n_rows }
+    , m_n_cols{ n_cols }
+    , m_words_per_row{ (n_cols + word_bits - 1) / word_bits }
+    , m_padding_value{ padding_value }
+    , m_words(m_n_rows * m_words_per_row)
+  {
+    if (m_padding_value) {
+      for (std::size_t row = 0; row < m_n_rows; ++row) {
+        row_words(row).back() |= tail_mask();
+      }
+    }
+  }
+
+  PaddedVector2D(std::size_t n_cols, bool padding_value, const std::vector<bool>& raw)
+    : PaddedVector2D{ raw.size() / n_cols, n_cols, padding_value }
+  {
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+      if (raw[i]) set(static_cast<int>(i / n_cols), static_cast<int>(i % n_cols), true);
+    }
+  }
+
+  bool at(int row, int column) const
+  {
+    if (row < 0 || row > static_cast<int>(rows()) - 1 || column < 0 || column > static_cast<int>(cols()) - 1) {
+      return m_padding_value;
+    } else {
+      return (m_words[word_index(row, column)] >> (column % word_bits)) & 1u;
+    }
+  }
+
+  // Writes outside of the grid are ignored.
+  void set(int row, int column, bool value)
+  {
+    if (row < 0 || row > static_cast<int>(rows()) - 1 || column < 0 || column > static_cast<int>(cols()) - 1) return;
+    const auto bit = word_t{ 1 } << (column % word_bits);
+    auto &word = m_words[word_index(row, column)];
+    word = value ? (word | bit) : (word & ~bit);
+  }
+
+  std::span<const word_t> row_words(std::size_t row) const
+  {
+    return std::span<const word_t>{ m_words.data() + row * m_words_per_row, m_words_per_row };
+  }
+
+  // Callers must keep the padding bits of the last word intact.
+  std::span<word_t> row_words(std::size_t row)
+  {
+    return std::span<word_t>{ m_words.data() + row * m_words_per_row, m_words_per_row };
+  }
+
+  // Number of cells that are set.
+  std::size_t count() const
+  {
+    std::size_t result = 0;
+    for (std::size_t row = 0; row < m_n_rows; ++row) {
+      const auto words = row_words(row);
+      for (std::size_t i = 0; i + 1 < words.size(); ++i) {
+        result += static_cast<std::size_t>(std::popcount(words[i]));
+      }
+      if (!words.empty()) result += static_cast<std::size_t>(std::popcount(words.back() & last_word_mask()));
+    }
+    return result;
+  }
+
+  std::size_t rows() const
+  {
+    return m_n_rows;
+  }
+
+  std::size_t cols() const
+  {
+    return m_n_cols;
+  }
+
+  std::size_t words_per_row() const
+  {
+    return m_words_per_row;
+  }
+
+private:
+  std::size_t word_index(int row, int column) const
+  {
+    return m_words_per_row * row + column / word_bits;
+  }
+
+  // Mask of the bits of the last word of a row that lie within the grid.
+  word_t last_word_mask() const
+  {
+    return ~tail_mask();
+  }
+
+  word_t tail_mask() const
+  {
+    const auto used = m_n_cols % word_bits;
+    return used == 0 ? word_t{ 0 } : ~word_t{ 0 } << used;
+  }
+
+  std::size_t m_n_rows;
+  std::size_t m_n_cols;
+  std::size_t m_words_per_row;
+  bool m_padding_value;
+  std::vector<word_t> m_words;
+};
+
 #endif // PADDED_VECTOR_2D_H
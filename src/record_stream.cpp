@@ -0,0 +1,71 @@
+#include "record_stream.h"
+#include "input_file_loader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+RecordStream::RecordStream(const std::filesystem::path& path, std::string delimiter, std::size_t buffer_size)
+  : m_file{ is_stdin(path) ? stdin : std::fopen(path.string().c_str(), "rb") }
+  , m_owned{ !is_stdin(path) }
+  , m_delimiter{ std::move(delimiter) }
+  , m_buffer(std::max(buffer_size, m_delimiter.size() + 1))
+{
+  if (m_file == nullptr) {
+    throw std::system_error{ errno, std::generic_category(), "Unable to open " + path.string() };
+  }
+}
+
+RecordStream::~RecordStream()
+{
+  if (m_owned) std::fclose(m_file);
+}
+
+std::optional<std::string_view> RecordStream::next()
+{
+  std::size_t searched = m_begin;
+  for (;;) {
+    const std::string_view pending(m_buffer.data() + m_begin, m_end - m_begin);
+    const auto found = pending.find(m_delimiter, searched - m_begin);
+    if (found != std::string_view::npos) {
+      m_begin += found + m_delimiter.size();
+      return pending.substr(0, found);
+    }
+    // A delimiter may straddle the refill, so rescan its possible start.
+    searched = m_end - std::min(m_end - m_begin, m_delimiter.size() - 1);
+    const auto offset = searched - m_begin;
+    if (!refill()) break;
+    searched = m_begin + offset;
+  }
+
+  if (m_begin == m_end) return std::nullopt;
+  const std::string_view last(m_buffer.data() + m_begin, m_end - m_begin);
+  m_begin = m_end;
+  return last;
+}
+
+// Moves the pending bytes to the front of the buffer, growing it when a
+// single record fills it completely, and reads more input behind them.
+bool RecordStream::refill()
+{
+  if (m_eof) return false;
+  if (m_begin > 0) {
+    std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+  }
+  if (m_end == m_buffer.size()) {
+    m_buffer.resize(2 * m_buffer.size());
+  }
+  const auto n = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+  if (n == 0) {
+    if (std::ferror(m_file)) {
+      throw std::system_error{ errno, std::generic_category(), "Unable to read the input" };
+    }
+    m_eof = true;
+    return false;
+  }
+  m_end += n;
+  return true;
+}
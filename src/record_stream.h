@@ -0,0 +1,39 @@
+#ifndef AOC2020_RECORD_STREAM_
+#define AOC2020_RECORD_STREAM_
+
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Reads delimiter separated records from a file, or from standard input for
+// "-", through a fixed-size buffer. Memory use is bounded by the buffer size
+// or the longest record, whichever is larger, regardless of the input size.
+class RecordStream
+{
+public:
+  explicit RecordStream(const std::filesystem::path& path, std::string delimiter = "\n", std::size_t buffer_size = 1 << 16);
+  ~RecordStream();
+
+  RecordStream(const RecordStream&) = delete;
+  RecordStream& operator=(const RecordStream&) = delete;
+
+  // The next record without its delimiter, or nullopt at the end of the
+  // input. The view is valid until the next call.
+  std::optional<std::string_view> next();
+
+private:
+  bool refill();
+
+  std::FILE* m_file;
+  bool m_owned;
+  bool m_eof{ false };
+  std::string m_delimiter;
+  std::vector<char> m_buffer;
+  std::size_t m_begin{ 0 };
+  std::size_t m_end{ 0 };
+};
+
+#endif // AOC2020_RECORD_STREAM_
@@ -0,0 +1,197 @@
+#include "result_cache.h"
+#include "input_file_loader.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#endif
+
+#ifdef _WIN32
+#define AOC2020_ENVIRON _environ
+#else
+extern char **environ;
+#define AOC2020_ENVIRON environ
+#endif
+
+namespace {
+
+#if defined(__linux__)
+// The first object reported by dl_iterate_phdr is the executable itself.
+int read_build_id(dl_phdr_info *info, std::size_t, void *data)
+{
+  auto &build_id = *static_cast<std::string *>(data);
+  for (int i = 0; i < info->dlpi_phnum && build_id.empty(); ++i) {
+    const auto &header = info->dlpi_phdr[i];
+    if (header.p_type != PT_NOTE) continue;
+
+    const auto *note = reinterpret_cast<const char *>(info->dlpi_addr + header.p_vaddr);
+    const auto *end = note + header.p_memsz;
+    while (note + sizeof(ElfW(Nhdr)) <= end) {
+      const auto *nhdr = reinterpret_cast<const ElfW(Nhdr) *>(note);
+      const auto *name = note + sizeof(ElfW(Nhdr));
+      const auto *desc = name + ((nhdr->n_namesz + 3) & ~3u);
+      if (nhdr->n_type == NT_GNU_BUILD_ID && nhdr->n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0) {
+        for (std::size_t j = 0; j < nhdr->n_descsz; ++j) {
+          build_id += fmt::format("{:02x}", static_cast<unsigned char>(desc[j]));
+        }
+        break;
+      }
+      note = desc + ((nhdr->n_descsz + 3) & ~3u);
+    }
+  }
+  return 1;
+}
+#endif
+
+// Falls back to the size and modification time of the executable when the
+// binary carries no GNU build id; empty if neither is available.
+std::string current_build_id()
+{
+  std::string build_id;
+#if defined(__linux__)
+  dl_iterate_phdr(read_build_id, &build_id);
+  if (!build_id.empty()) return build_id;
+
+  std::error_code ec;
+  const auto exe = std::filesystem::read_symlink("/proc/self/exe", ec);
+  if (ec) return build_id;
+  const auto size = std::filesystem::file_size(exe, ec);
+  const auto time = std::filesystem::last_write_time(exe, ec);
+  if (!ec) build_id = fmt::format("{:x}-{:x}", size, time.time_since_epoch().count());
+#endif
+  return build_id;
+}
+
+// Two independent 64-bit lanes over 8-byte words; strong enough to tell
+// inputs apart, and fast enough not to matter next to parsing them.
+class Hasher
+{
+public:
+  void update(std::string_view data)
+  {
+    std::size_t i = 0;
+    for (; i + 8 <= data.size(); i += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, data.data() + i, 8);
+      mix(word);
+    }
+    std::uint64_t tail = 0;
+    if (i < data.size()) std::memcpy(&tail, data.data() + i, data.size() - i);
+    mix(tail ^ (static_cast<std::uint64_t>(data.size()) << 56));
+  }
+
+  std::string hex() const
+  {
+    return fmt::format("{:016x}{:016x}", m_a, m_b);
+  }
+
+private:
+  void mix(std::uint64_t word)
+  {
+    m_a = (m_a ^ word) * 0x9e3779b97f4a7c15ull;
+    m_a ^= m_a >> 29;
+    m_b = (m_b ^ word) * 0xff51afd7ed558ccdull;
+    m_b ^= m_b >> 32;
+  }
+
+  std::uint64_t m_a{ 0x243f6a8885a308d3ull };
+  std::uint64_t m_b{ 0x13198a2e03707344ull };
+};
+
+// AOC_* variables other than the cache and timing switches may change the
+// answers (turn counts, preamble sizes), so they are part of the key.
+std::vector<std::string_view> answer_options()
+{
+  std::vector<std::string_view> options;
+  for (char **env = AOC2020_ENVIRON; env != nullptr && *env != nullptr; ++env) {
+    const std::string_view entry{ *env };
+    if (entry.starts_with("AOC_") && !entry.starts_with("AOC_CACHE_DIR=") && !entry.starts_with("AOC_TIMING=")) {
+      options.push_back(entry);
+    }
+  }
+  std::sort(options.begin(), options.end());
+  return options;
+}
+
+}// namespace
+
+ResultCache::ResultCache(std::filesystem::path directory)
+  : m_directory{ std::move(directory) }
+  , m_build_id{ current_build_id() }
+{}
+
+std::optional<std::string> ResultCache::key(int day, const std::filesystem::path &input) const
+{
+  if (m_build_id.empty() || is_stdin(input)) return std::nullopt;
+
+  Hasher hasher;
+  hasher.update(map_input(input).view());
+  for (const auto option : answer_options()) {
+    hasher.update(option);
+  }
+  return fmt::format("{}-day{}-{}", m_build_id, day, hasher.hex());
+}
+
+std::optional<CachedResult> ResultCache::find(const std::string &key) const
+{
+  std::ifstream is{ m_directory / (key + ".txt") };
+  CachedResult result;
+  if (std::getline(is, result.answers.part1) && std::getline(is, result.answers.part2) && std::getline(is, result.timing)) {
+    return result;
+  }
+  return std::nullopt;
+}
+
+// Entries are written under a temporary name and renamed into place so
+// concurrent runs never read a partial entry. Failing to store is not an
+// error, the answers were computed anyway.
+void ResultCache::store(const std::string &key, const CachedResult &result) const
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  const auto path = m_directory / (key + ".txt");
+  auto temporary = path;
+  temporary += fmt::format(".{:x}.tmp", std::random_device{}());
+  {
+    std::ofstream os{ temporary };
+    os << result.answers.part1 << '\n'
+       << result.answers.part2 << '\n'
+       << result.timing << '\n';
+    if (!os) return;
+  }
+  std::filesystem::rename(temporary, path, ec);
+  if (ec) std::filesystem::remove(temporary, ec);
+}
+
+std::optional<ResultCache> parse_cache_options(int &argc, char **argv)
+{
+  std::optional<std::filesystem::path> directory;
+  if (const auto *env = std::getenv("AOC_CACHE_DIR"); env != nullptr && *env != '\0') {
+    directory = env;
+  }
+
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{ argv[i] };
+    if (arg == "--cache" && i + 1 < argc) {
+      directory = argv[++i];
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argv[kept] = nullptr;
+  argc = kept;
+
+  if (!directory) return std::nullopt;
+  return ResultCache{ *directory };
+}
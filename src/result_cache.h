@@ -0,0 +1,41 @@
+#ifndef AOC2020_RESULT_CACHE_
+#define AOC2020_RESULT_CACHE_
+
+#include "solver.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+struct CachedResult
+{
+  Answers answers;
+  // Timing JSON of the run that filled the entry; empty if it was untimed.
+  std::string timing;
+};
+
+// On-disk cache of answers keyed by the running binary's build id, the day,
+// a hash of the input bytes and the AOC_* options in the environment. A
+// rebuild or any change of the input or the options misses the cache.
+class ResultCache
+{
+public:
+  explicit ResultCache(std::filesystem::path directory);
+
+  // Key of the entry for the input; nullopt when the input cannot be
+  // cached, as standard input is consumed by reading it.
+  std::optional<std::string> key(int day, const std::filesystem::path &input) const;
+
+  std::optional<CachedResult> find(const std::string &key) const;
+  void store(const std::string &key, const CachedResult &result) const;
+
+private:
+  std::filesystem::path m_directory;
+  std::string m_build_id;
+};
+
+// Enabled by a non-empty AOC_CACHE_DIR or by --cache <directory>; the flag
+// is removed from argv.
+std::optional<ResultCache> parse_cache_options(int &argc, char **argv);
+
+#endif // AOC2020_RESULT_CACHE_
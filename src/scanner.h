@@ -0,0 +1,186 @@
+#ifndef AOC2020_SCANNER_
+#define AOC2020_SCANNER_
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AOC2020_SCANNER_SSE2
+#endif
+
+// First occurrence of either byte in [begin, end), or end. Scans sixteen
+// bytes at a time where SSE2 is available.
+inline const char* find_either(const char* begin, const char* end, char a, char b)
+{
+#ifdef AOC2020_SCANNER_SSE2
+  const auto va = _mm_set1_epi8(a);
+  const auto vb = _mm_set1_epi8(b);
+  for (; end - begin >= 16; begin += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+    if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits)); mask != 0) {
+      return begin + std::countr_zero(mask);
+    }
+  }
+#endif
+  for (; begin != end; ++begin) {
+    if (*begin == a || *begin == b) return begin;
+  }
+  return end;
+}
+
+// Occurrences of c in [begin, end). Bytes up to readable_end may be loaded
+// and are masked off, so short ranges inside a larger buffer still take the
+// sixteen-byte path; ranges too close to readable_end are counted bytewise.
+inline std::size_t count_byte(const char* begin, const char* end, const char* readable_end, char c)
+{
+  std::size_t count = 0;
+#ifdef AOC2020_SCANNER_SSE2
+  const auto vc = _mm_set1_epi8(c);
+  for (; begin < end && readable_end - begin >= 16; begin += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, vc)));
+    if (end - begin < 16) mask &= (1u << (end - begin)) - 1;
+    count += static_cast<std::size_t>(std::popcount(mask));
+  }
+  if (begin >= end) return count;
+#endif
+  for (; begin != end; ++begin) {
+    count += *begin == c;
+  }
+  return count;
+}
+
+// Parses the whole of str as a number; throws if anything is left over.
+template<std::integral T>
+T to_number(std::string_view str)
+{
+  T result;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+  if (ec != std::errc{} || ptr != str.data() + str.size()) {
+    throw std::runtime_error{ "Invalid number \"" + std::string{ str } + "\"" };
+  }
+  return result;
+}
+
+// Cursor over a text buffer. Tokens are returned as views into the buffer
+// and numbers are parsed in place, so scanning never allocates.
+class Scanner
+{
+public:
+  explicit Scanner(std::string_view text)
+    : m_pos{ text.data() }
+    , m_end{ text.data() + text.size() }
+  {}
+
+  bool empty() const
+  {
+    return m_pos == m_end;
+  }
+
+  std::string_view rest() const
+  {
+    return std::string_view(m_pos, m_end);
+  }
+
+  char peek() const
+  {
+    return empty() ? '\0' : *m_pos;
+  }
+
+  Scanner& skip_whitespace()
+  {
+    while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) ++m_pos;
+    return *this;
+  }
+
+  void skip(std::size_t n)
+  {
+    m_pos += std::min(n, static_cast<std::size_t>(m_end - m_pos));
+  }
+
+  // Consumes the literal if the remaining text starts with it.
+  bool consume(std::string_view literal)
+  {
+    if (!rest().starts_with(literal)) return false;
+    m_pos += literal.size();
+    return true;
+  }
+
+  bool consume(char c)
+  {
+    if (empty() || *m_pos != c) return false;
+    ++m_pos;
+    return true;
+  }
+
+  void expect(std::string_view literal)
+  {
+    if (!consume(literal)) {
+      throw std::runtime_error{ "Expected \"" + std::string{ literal } + "\"" };
+    }
+  }
+
+  // Text up to the delimiter, or the rest of the buffer when there is none.
+  // The delimiter itself is consumed.
+  std::string_view until(char delimiter)
+  {
+    if (empty()) return {};
+    const auto found = static_cast<const char*>(std::memchr(m_pos, delimiter, static_cast<std::size_t>(m_end - m_pos)));
+    return take(found == nullptr ? m_end : found, 1);
+  }
+
+  std::string_view until(std::string_view delimiter)
+  {
+    if (delimiter.size() == 1) return until(delimiter.front());
+    const auto found = rest().find(delimiter);
+    return take(found == std::string_view::npos ? m_end : m_pos + found, delimiter.size());
+  }
+
+  // Text up to either delimiter; the delimiter found is consumed.
+  std::string_view until_either(char a, char b)
+  {
+    return take(find_either(m_pos, m_end, a, b), 1);
+  }
+
+  std::string_view line()
+  {
+    return until('\n');
+  }
+
+  // Skips leading blanks, accepts an explicit '+' sign and parses the number
+  // that follows. Throws if there is none.
+  template<std::integral T>
+  T number()
+  {
+    while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\t')) ++m_pos;
+    if (m_pos != m_end && *m_pos == '+') ++m_pos;
+    T result;
+    const auto [ptr, ec] = std::from_chars(m_pos, m_end, result);
+    if (ec != std::errc{}) {
+      throw std::runtime_error{ "Expected a number at \"" + std::string{ rest().substr(0, 16) } + "\"" };
+    }
+    m_pos = ptr;
+    return result;
+  }
+
+private:
+  std::string_view take(const char* token_end, std::size_t delimiter_size)
+  {
+    const std::string_view token(m_pos, token_end);
+    m_pos = token_end == m_end ? m_end : token_end + delimiter_size;
+    return token;
+  }
+
+  const char* m_pos;
+  const char* m_end;
+};
+
+#endif // AOC2020_SCANNER_
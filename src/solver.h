@@ -0,0 +1,15 @@
+#ifndef AOC2020_SOLVER_
+#define AOC2020_SOLVER_
+
+#include <filesystem>
+#include <string>
+
+struct Answers
+{
+  std::string part1;
+  std::string part2;
+};
+
+using solver_t = Answers (*)(const std::filesystem::path &input);
+
+#endif // AOC2020_SOLVER_